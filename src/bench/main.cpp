@@ -0,0 +1,169 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Read throughput benchmark. Compares the file readers of the library (raw reading and full loading) against a plain
+// fgetc loop, which is how the library used to read files.
+//
+// Usage: bench <file> [size in MiB]
+// If a size is given, the file is (re)generated first by repeating the data rows of test/env_data.csv. Use a file 
+// larger than the page cache (or drop caches between runs) to measure the device rather than memory.
+
+#include "slightcsv.hpp"
+#include "slightinput.hpp"
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::endl;
+using std::ifstream;
+using utils::SlightCSV;
+using utils::SlightRowHandler;
+using utils::SlightInput;
+using utils::SlightFileInput;
+using utils::SlightMmapInput;
+using utils::SlightUringInput;
+
+// row handler dropping rows (streaming mode keeps memory usage flat for multi-GB files)
+class NullRowHandler: public SlightRowHandler {
+    public:
+        void handleRow(const vector<string> & /*t_cells*/, const size_t /*t_row_id*/, const bool /*t_is_header*/) {
+        }
+};
+
+static double getTime(void) {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void report(const string &t_name, const size_t t_bytes, const double t_seconds) {
+    cout << t_name << ": " << t_seconds << " s, " << t_bytes / t_seconds / (1024 * 1024) << " MiB/s" << endl;
+}
+
+static void generate(const string &t_filename, const size_t t_size_mib) {
+    ifstream source("../test/env_data.csv");
+    string header;
+    string row;
+    string rows;
+    getline(source, header);
+    while (getline(source, row)) {
+        rows += row + "\n";
+    }
+    FILE *target = fopen(t_filename.c_str(), "wb");
+    fputs((header + "\n").c_str(), target);
+    for (size_t written = 0; written < t_size_mib * 1024 * 1024; written += rows.size()) {
+        fwrite(rows.data(), 1, rows.size(), target);
+    }
+    fclose(target);
+}
+
+static unsigned benchRaw(const string &t_name, SlightInput &t_input) {
+    const char *data;
+    size_t size;
+    size_t total = 0;
+    unsigned checksum = 0;
+    double start = getTime();
+    // touch every byte, mapped pages are only read when accessed
+    while (t_input.read(data, size)) {
+        for (size_t i = 0; i < size; ++i) {
+            checksum += data[i];
+        }
+        total += size;
+    }
+    report(t_name, total, getTime() - start);
+    t_input.close();
+    return checksum;
+}
+
+static void benchLoad(const string &t_name, const string &t_filename, const SlightCSV::ReadMode t_mode, 
+    const size_t t_size) {
+
+    SlightCSV scsv;
+    NullRowHandler handler;
+    scsv.setFileName(t_filename);
+    scsv.setSeparator(";");
+    scsv.setReadMode(t_mode);
+    scsv.setBufferCount(8);
+    scsv.setRowHandler(&handler);
+    double start = getTime();
+    scsv.loadData();
+    report(t_name, t_size, getTime() - start);
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <file> [size in MiB]" << endl;
+        return 1;
+    }
+    string filename = argv[1];
+    if (argc > 2) {
+        generate(filename, atoi(argv[2]));
+    }
+
+    // raw reading (no parsing)
+    FILE *in_file = fopen(filename.c_str(), "rb");
+    if (!in_file) {
+        cout << "Cannot open " << filename << endl;
+        return 1;
+    }
+    size_t size = 0;
+    unsigned checksum = 0;
+    int in_char;
+    double start = getTime();
+    while (in_char = fgetc(in_file), in_char != EOF) {
+        checksum += in_char;
+        ++size;
+    }
+    report("raw fgetc", size, getTime() - start);
+    fclose(in_file);
+
+    SlightFileInput file_input;
+    file_input.open(filename);
+    checksum -= benchRaw("raw stdio blocks", file_input);
+
+    SlightMmapInput mmap_input;
+    mmap_input.open(filename);
+    benchRaw("raw mmap", mmap_input);
+
+    if (SlightUringInput::isAvailable()) {
+        SlightUringInput uring_input;
+        uring_input.setQueueDepth(8);
+        uring_input.open(filename);
+        benchRaw("raw io_uring", uring_input);
+    } else {
+        cout << "raw io_uring: not available" << endl;
+    }
+
+    if (checksum) {
+        cout << "checksum mismatch" << endl;
+    }
+
+    // full loading (parsing included, rows dropped)
+    benchLoad("load stdio", filename, SlightCSV::READ_MODE_STDIO, size);
+    benchLoad("load mmap", filename, SlightCSV::READ_MODE_MMAP, size);
+    benchLoad("load read-ahead", filename, SlightCSV::READ_MODE_READ_AHEAD, size);
+    benchLoad("load io_uring", filename, SlightCSV::READ_MODE_IO_URING, size);
+
+    return 0;
+}
@@ -17,14 +17,271 @@
 #include "slightcsv.hpp"
 #include "slightcsvprivate.hpp"
 #include "slightrow.hpp"
+#include "slightinput.hpp"
 #include "u8char.hpp"
 
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <new>
+
+#ifndef _WIN32
+#include <glob.h>
+#include <unistd.h>
+#endif
 
 using std::set;
 using std::map;
 using std::pair;
 using utils::U8char;
+using utils::SlightInput;
+using utils::SlightMemoryInput;
+using utils::SlightFileInput;
+using utils::SlightMmapInput;
+using utils::SlightReadAheadInput;
+using utils::SlightUringInput;
+using utils::SlightDecompressInput;
+
+// special characters recognized by the parser
+static const U8char U8_CR("\r");
+static const U8char U8_NL("\n");
+static const U8char U8_BOM("\xef\xbb\xbf");
+
+// replacement character of invalid UTF-8 sequences (U+FFFD)
+static const char UTF8_REPLACEMENT[] = "\xef\xbf\xbd";
+
+// number of invalid UTF-8 sequences recorded with their offsets (all of them are counted)
+static const size_t UTF8_ERROR_RECORD_LIMIT = 1000;
+
+// number of malformed rows recorded with their raw text (all of them are counted)
+static const size_t ROW_ERROR_RECORD_LIMIT = 1000;
+
+// default size of the file read buffer (1 MiB)
+static const size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+// default number of read-ahead buffers (double buffering)
+static const size_t DEFAULT_BUFFER_COUNT = 2;
+
+// number of leading file bytes compared to recognize a replaced file on incremental reload
+static const size_t RELOAD_HEAD_SIZE = 64;
+
+// default minimum size of the chunks of a file parsed in parallel (16 MiB)
+static const size_t DEFAULT_MIN_CHUNK_SIZE = 16 * 1024 * 1024;
+
+// number of bytes of a run compared one by one by the specialized parsers before the scanner takes over
+static const ptrdiff_t DIALECT_SCAN_THRESHOLD = 8;
+
+// errors of the files loaded on worker threads (exceptions cannot cross threads, they are thrown again by the 
+// calling thread)
+enum LoadError {
+    LOAD_OK,
+    LOAD_FILENAME_ERROR,
+    LOAD_READ_ERROR,
+    LOAD_COMPRESSION_ERROR,
+    LOAD_CELLCNT_ERROR,
+    LOAD_HEADER_ERROR,
+    LOAD_UTF8_ERROR,
+    LOAD_MEMORY_ERROR
+};
+
+// phases of parallel loading (the chunks of a file are processed on multiple threads in each phase)
+enum ChunkPhase {
+    CHUNK_COUNT_ESCAPES,
+    CHUNK_INDEX_ROWS,
+    CHUNK_LOAD_ROWS
+};
+
+namespace utils {
+
+    // files and results shared by the threads loading multiple files
+    class SlightLoadJob {
+
+        public:
+            const vector<string> *m_filenames;
+            vector<SlightCSV*> m_parsers;
+            vector<LoadError> m_errors;
+            size_t m_next_index;
+            pthread_mutex_t m_mutex;
+            // data rows needed with a row limit (skipped and limited rows, zero if not limited), the files loaded and
+            // their data rows (no more files are taken once the files before them hold the rows needed)
+            size_t m_row_goal;
+            vector<bool> m_loaded;
+            vector<size_t> m_data_rows;
+            bool m_goal_reached;
+
+    };
+
+    // chunks of a file and results shared by the threads parsing them (chunk boundaries, escape characters counted in
+    // the chunks and the escaped state at their beginning, ends of the rows found in the chunks, the row index made of
+    // them and the first row of each block of rows parsed into the data matrix)
+    class SlightChunkJob {
+
+        public:
+            ChunkPhase m_phase;
+            vector<size_t> m_offsets;
+            vector<size_t> m_escape_counts;
+            vector<bool> m_is_escaped;
+            vector<vector<size_t> > m_row_ends;
+            vector<size_t> m_row_index;
+            vector<size_t> m_block_rows;
+            SlightMatrix *m_target;
+            vector<SlightCSV*> m_parsers;
+            vector<LoadError> m_errors;
+            size_t m_next_index;
+            pthread_mutex_t m_mutex;
+
+    };
+
+    // row handler passing the rows of multiple files to the user's handler as if they came from a single file
+    class SlightMultiFileHandler: public SlightRowHandler {
+
+        public:
+            void handleRow(const vector<string> &t_cells, const size_t t_row_id, const bool t_is_header) {
+                (void)t_row_id;
+                // header rows are passed from the first file only
+                if (t_is_header) {
+                    ++m_header_count;
+                    if (m_file_index) {
+                        return;
+                    }
+                }
+                if (m_cell_count && t_cells.size() != m_cell_count) {
+                    throw slightcsv_format_cellcnt_error();
+                }
+                m_cell_count = t_cells.size();
+                m_target->handleRow(t_cells, m_row_count++, t_is_header);
+            }
+
+            SlightRowHandler *m_target;
+            size_t m_file_index;
+            size_t m_cell_count;
+            size_t m_header_count;
+            size_t m_row_count;
+
+    };
+
+} // utils
+
+// throw the exception of an error caught on a worker thread
+static void throwLoadError(const LoadError t_error) {
+    switch (t_error) {
+        case LOAD_OK:
+            return;
+        case LOAD_FILENAME_ERROR:
+            throw utils::slightcsv_filename_error();
+        case LOAD_COMPRESSION_ERROR:
+            throw utils::slightcsv_compression_error();
+        case LOAD_CELLCNT_ERROR:
+            throw utils::slightcsv_format_cellcnt_error();
+        case LOAD_HEADER_ERROR:
+            throw utils::slightcsv_format_header_error();
+        case LOAD_UTF8_ERROR:
+            throw utils::u8char_format_error();
+        case LOAD_MEMORY_ERROR:
+            throw std::bad_alloc();
+        default:
+            throw utils::slightcsv_read_error();
+    }
+}
+
+// get the error of the exception being handled on a worker thread
+static LoadError getLoadError(void) {
+    try {
+        throw;
+    } catch (const utils::slightcsv_filename_error &e) {
+        return LOAD_FILENAME_ERROR;
+    } catch (const utils::slightcsv_compression_error &e) {
+        return LOAD_COMPRESSION_ERROR;
+    } catch (const utils::slightcsv_format_cellcnt_error &e) {
+        return LOAD_CELLCNT_ERROR;
+    } catch (const utils::slightcsv_format_header_error &e) {
+        return LOAD_HEADER_ERROR;
+    } catch (const utils::u8char_format_error &e) {
+        return LOAD_UTF8_ERROR;
+    } catch (const std::bad_alloc &e) {
+        return LOAD_MEMORY_ERROR;
+    } catch (...) {
+        return LOAD_READ_ERROR;
+    }
+}
+
+// get the number of threads to use (zero means the number of processors online)
+static size_t getThreadCountOnline(const size_t t_thread_count) {
+    size_t thread_count = t_thread_count;
+#ifndef _WIN32
+    if (!thread_count) {
+        long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = cpu_count > 0 ? cpu_count : 1;
+    }
+#endif
+    return std::max((size_t)1, thread_count);
+}
+
+// run a job on the calling thread and on additional threads (fewer if they cannot be started)
+static void runThreads(void *(*t_function)(void *), void *t_job, const size_t t_thread_count) {
+    vector<pthread_t> threads(t_thread_count - 1);
+    size_t started_count = 0;
+    for (; started_count < threads.size(); ++started_count) {
+        if (pthread_create(&threads[started_count], 0, t_function, t_job) != 0) {
+            break;
+        }
+    }
+    t_function(t_job);
+    for (size_t i = 0; i < started_count; ++i) {
+        pthread_join(threads[i], 0);
+    }
+}
+
+// set up the scanner finding the bytes the parser has to look at one by one (new lines, escape, stripped and replaced
+// characters, the separator if rows are split into cells while parsing), the runs of other bytes are copied at once
+static bool setupScanner(utils::SlightScanner &t_scanner, const U8char &t_separator, const U8char &t_escape, 
+    const set<U8char> &t_strip_chars, const map<U8char, U8char> &t_rep_chars) {
+    t_scanner.clear();
+    // NUL bytes are dropped character by character, multibyte characters are stop bytes unless the input is validated
+    bool retval = t_scanner.addTarget('\r') && t_scanner.addTarget('\n') && t_scanner.addStop(0);
+    if (t_separator && t_separator.size() == 1) {
+        retval = retval && t_scanner.addTarget(t_separator.getByte(0));
+    }
+    if (t_escape && t_escape.size() == 1) {
+        retval = retval && t_scanner.setEscape(t_escape.getByte(0));
+    }
+    for (set<U8char>::const_iterator it = t_strip_chars.begin(); it != t_strip_chars.end(); ++it) {
+        if (it->size() == 1) {
+            retval = retval && t_scanner.addStop(it->getByte(0));
+        }
+    }
+    for (map<U8char, U8char>::const_iterator it = t_rep_chars.begin(); it != t_rep_chars.end(); ++it) {
+        if (it->first.size() == 1) {
+            retval = retval && t_scanner.addStop(it->first.getByte(0));
+        }
+    }
+    return retval;
+}
+
+// check if replacing characters adds or removes escape characters (the escaped state of the row and its cells would
+// differ)
+static bool isEscapeReplaced(const U8char &t_escape, const map<U8char, U8char> &t_rep_chars) {
+    if (!t_escape) {
+        return false;
+    }
+    for (map<U8char, U8char>::const_iterator it = t_rep_chars.begin(); it != t_rep_chars.end(); ++it) {
+        if (it->first == t_escape || it->second == t_escape) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// read the first bytes of an open file (at most t_size bytes, fewer if the file is shorter)
+static string readHead(SlightFileInput &t_input, const size_t t_size) {
+    string head;
+    const char *data;
+    size_t size;
+    while (head.size() < t_size && t_input.read(data, size)) {
+        head.append(data, std::min(size, t_size - head.size()));
+    }
+    return head;
+}
 
 utils::SlightCSV::SlightCSV(void) {
     // allocate object holding data members dynamically
@@ -76,175 +333,1715 @@ void utils::SlightCSV::setEscape(const string t_escape) {
     m_csvp->m_row.setEscape(t_escape.c_str());
 }
 
-void utils::SlightCSV::getEscape(string &t_target) const {
-    if (!m_csvp->m_escape) {
-        throw slightcsv_escape_error();
-    }
-    t_target = m_csvp->m_escape.getString();
+void utils::SlightCSV::getEscape(string &t_target) const {
+    if (!m_csvp->m_escape) {
+        throw slightcsv_escape_error();
+    }
+    t_target = m_csvp->m_escape.getString();
+}
+
+void utils::SlightCSV::setStripChars(const set<string> &t_strip_chars) {
+    if (!t_strip_chars.size()) {
+        throw slightcsv_strip_error();
+    }
+    // convert string set to U8char set
+    set<U8char> u8_strip_chars;
+    // iterate through set
+    for (set<string>::const_iterator it = t_strip_chars.begin(); it != t_strip_chars.end(); ++it) {
+        // try to create U8char from character supplied as string
+        U8char u8c;
+        try {
+            u8c = (*it).c_str();
+        } catch (const u8char_format_error &e) {
+            // conversion failed because of invalid string input
+            throw slightcsv_strip_error();
+        }
+        // insert converted U8char into set
+        u8_strip_chars.insert(u8c);
+    }
+    m_csvp->m_strip_chars = u8_strip_chars;
+}
+
+void utils::SlightCSV::getStripChars(set<string> &t_target) const {
+    if (!m_csvp->m_strip_chars.size()) {
+        throw slightcsv_strip_error();
+    }
+    t_target.clear();
+    // convert U8char set to string set
+    for (set<U8char>::const_iterator it = m_csvp->m_strip_chars.begin(); it != m_csvp->m_strip_chars.end(); ++it) {
+        t_target.insert((*it).getString());
+    }
+}
+
+void utils::SlightCSV::setReplaceChars(const map<string, string> &t_rep_chars) {
+    if (!t_rep_chars.size()) {
+        throw slightcsv_replace_error();
+    }
+    // convert string map to U8char map
+    map<U8char, U8char> u8_rep_chars;
+    // iterate through map
+    for (map<string, string>::const_iterator it = t_rep_chars.begin(); it != t_rep_chars.end(); ++it) {
+        pair<U8char, U8char> p;
+        // try to create U8chars from characters supplied as strings
+        try {
+            p.first = U8char((*it).first.c_str());
+            p.second = U8char((*it).second.c_str());
+        } catch (const u8char_format_error &e) {
+            // conversion failed because of invalid string input
+            throw slightcsv_replace_error();
+        }
+        // insert converted pair into map
+        u8_rep_chars.insert(p);
+    }
+    m_csvp->m_rep_chars = u8_rep_chars;
+}
+
+void utils::SlightCSV::getReplaceChars(map<string, string> &t_target) const {
+    if (!m_csvp->m_rep_chars.size()) {
+        throw slightcsv_replace_error();
+    }
+    t_target.clear();
+    // convert U8char map to string map
+    for(map<U8char, U8char>::const_iterator it = m_csvp->m_rep_chars.begin(); it != m_csvp->m_rep_chars.end(); ++it) {
+        pair<string, string> p((*it).first.getString(), (*it).second.getString());
+        t_target.insert(p);
+    }
+}
+
+void utils::SlightCSV::setReadMode(const ReadMode t_read_mode) {
+    m_csvp->m_read_mode = t_read_mode;
+}
+
+utils::SlightCSV::ReadMode utils::SlightCSV::getReadMode(void) const {
+    return m_csvp->m_read_mode;
+}
+
+void utils::SlightCSV::setBufferSize(const size_t t_buffer_size) {
+    if (!t_buffer_size) {
+        throw slightcsv_buffer_error();
+    }
+    m_csvp->m_buffer_size = t_buffer_size;
+}
+
+size_t utils::SlightCSV::getBufferSize(void) const {
+    return m_csvp->m_buffer_size;
+}
+
+void utils::SlightCSV::setBufferCount(const size_t t_buffer_count) {
+    if (t_buffer_count < 2) {
+        throw slightcsv_buffer_error();
+    }
+    m_csvp->m_buffer_count = t_buffer_count;
+}
+
+size_t utils::SlightCSV::getBufferCount(void) const {
+    return m_csvp->m_buffer_count;
+}
+
+double utils::SlightCSV::getStallTime(void) const {
+    return m_csvp->m_stall_time;
+}
+
+void utils::SlightCSV::setRowHandler(SlightRowHandler *t_row_handler) {
+    m_csvp->m_row_handler = t_row_handler;
+}
+
+utils::SlightRowHandler* utils::SlightCSV::getRowHandler(void) const {
+    return m_csvp->m_row_handler;
+}
+
+void utils::SlightCSV::setRowSkip(const size_t t_row_skip) {
+    m_csvp->m_row_skip = t_row_skip;
+}
+
+size_t utils::SlightCSV::getRowSkip(void) const {
+    return m_csvp->m_row_skip;
+}
+
+void utils::SlightCSV::setHeaderMode(const HeaderMode t_header_mode) {
+    m_csvp->m_header_mode = t_header_mode;
+}
+
+utils::SlightCSV::HeaderMode utils::SlightCSV::getHeaderMode(void) const {
+    return m_csvp->m_header_mode;
+}
+
+void utils::SlightCSV::setHeaderRowCount(const size_t t_row_count) {
+    m_csvp->m_header_row_count = t_row_count;
+}
+
+size_t utils::SlightCSV::getHeaderRowCount(void) const {
+    return m_csvp->m_header_row_count;
+}
+
+void utils::SlightCSV::setUtf8ErrorPolicy(const Utf8ErrorPolicy t_policy) {
+    m_csvp->m_utf8_policy = t_policy;
+}
+
+utils::SlightCSV::Utf8ErrorPolicy utils::SlightCSV::getUtf8ErrorPolicy(void) const {
+    return m_csvp->m_utf8_policy;
+}
+
+size_t utils::SlightCSV::getUtf8ErrorCount(void) const {
+    return m_csvp->m_utf8_error_count;
+}
+
+void utils::SlightCSV::getUtf8Errors(vector<Utf8Error> &t_target) const {
+    t_target = m_csvp->m_utf8_errors;
+}
+
+void utils::SlightCSV::setRowErrorPolicy(const RowErrorPolicy t_policy) {
+    m_csvp->m_row_policy = t_policy;
+}
+
+utils::SlightCSV::RowErrorPolicy utils::SlightCSV::getRowErrorPolicy(void) const {
+    return m_csvp->m_row_policy;
+}
+
+size_t utils::SlightCSV::getRowErrorCount(void) const {
+    return m_csvp->m_row_error_count;
+}
+
+void utils::SlightCSV::getRowErrors(vector<RowError> &t_target) const {
+    t_target = m_csvp->m_row_errors;
+}
+
+void utils::SlightCSV::setEmptyCellMode(const EmptyCellMode t_mode) {
+    m_csvp->m_empty_cell_mode = t_mode;
+    // the row object splits lines into cells if rows are not split while parsing
+    m_csvp->m_row.setEmptyCellZero(t_mode == EMPTY_CELL_ZERO);
+}
+
+utils::SlightCSV::EmptyCellMode utils::SlightCSV::getEmptyCellMode(void) const {
+    return m_csvp->m_empty_cell_mode;
+}
+
+void utils::SlightCSV::setNullPolicy(const NullPolicy t_policy) {
+    m_csvp->m_data_matrix.setNullPolicy(t_policy == NULL_POLICY_THROW ? SlightMatrix::NULL_POLICY_THROW : 
+        SlightMatrix::NULL_POLICY_VALUE);
+}
+
+utils::SlightCSV::NullPolicy utils::SlightCSV::getNullPolicy(void) const {
+    return m_csvp->m_data_matrix.getNullPolicy() == SlightMatrix::NULL_POLICY_THROW ? NULL_POLICY_THROW : 
+        NULL_POLICY_VALUE;
+}
+
+void utils::SlightCSV::setNullValue(const string &t_value) {
+    m_csvp->m_data_matrix.setNullValue(t_value);
+}
+
+string utils::SlightCSV::getNullValue(void) const {
+    return m_csvp->m_data_matrix.getNullValue();
+}
+
+void utils::SlightCSV::setUtf8Validation(const bool t_is_enabled) {
+    m_csvp->m_utf8_validation = t_is_enabled;
+}
+
+bool utils::SlightCSV::getUtf8Validation(void) const {
+    return m_csvp->m_utf8_validation;
+}
+
+void utils::SlightCSV::setRowLimit(const size_t t_row_limit) {
+    m_csvp->m_row_limit = t_row_limit;
+}
+
+size_t utils::SlightCSV::getRowLimit(void) const {
+    return m_csvp->m_row_limit;
+}
+
+void utils::SlightCSV::setThreadCount(const size_t t_thread_count) {
+    m_csvp->m_thread_count = t_thread_count;
+}
+
+size_t utils::SlightCSV::getThreadCount(void) const {
+    return m_csvp->m_thread_count;
+}
+
+void utils::SlightCSV::setChunkSize(const size_t t_chunk_size) {
+    if (!t_chunk_size) {
+        throw slightcsv_buffer_error();
+    }
+    m_csvp->m_min_chunk_size = t_chunk_size;
+}
+
+size_t utils::SlightCSV::getChunkSize(void) const {
+    return m_csvp->m_min_chunk_size;
+}
+
+size_t utils::SlightCSV::loadData(void) {
+
+    if (!m_csvp->m_filename.size()) {
+        throw slightcsv_filename_error();
+    }
+
+    if (!m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    m_csvp->m_reload_valid = false;
+
+    // large files are split into chunks parsed on multiple threads
+    size_t retval;
+    bool is_seekable = true;
+    if (loadParallel()) {
+        retval = m_csvp->m_data_matrix.getRowCount();
+    } else {
+        retval = loadFile(is_seekable);
+    }
+
+    // remember the file loaded, so appended rows can be loaded incrementally (compressed files and pipes cannot be 
+    // resumed)
+    if (!m_csvp->m_compressed && is_seekable) {
+        SlightFileInput in_head;
+        try {
+            in_head.open(m_csvp->m_filename);
+            m_csvp->m_reload_file_id = in_head.getFileId();
+            m_csvp->m_reload_head = readHead(in_head, std::min(RELOAD_HEAD_SIZE, m_csvp->m_row_end_offset));
+            m_csvp->m_reload_filename = m_csvp->m_filename;
+            saveReloadState();
+        } catch (const slightinput_error &e) {
+            // file is gone already, next reload loads it fully
+        }
+    }
+
+    return retval;
+}
+
+size_t utils::SlightCSV::loadFile(bool &t_is_seekable) {
+
+    SlightFileInput in_file;
+    SlightMmapInput in_mmap;
+    SlightUringInput in_uring;
+    SlightInput *in_base = 0;
+
+#ifndef _WIN32
+    if (m_csvp->m_read_mode == READ_MODE_MMAP) {
+        try {
+            in_mmap.open(m_csvp->m_filename);
+        } catch (const slightinput_open_error &e) {
+            throw slightcsv_filename_error();
+        }
+        in_base = &in_mmap;
+    }
+#endif
+
+    if (m_csvp->m_read_mode == READ_MODE_IO_URING) {
+        in_uring.setBufferSize(m_csvp->m_buffer_size);
+        in_uring.setQueueDepth(m_csvp->m_buffer_count);
+        try {
+            in_uring.open(m_csvp->m_filename);
+            in_base = &in_uring;
+        } catch (const slightinput_unsupported_error &e) {
+            // fall back to stream reading
+        } catch (const slightinput_open_error &e) {
+            throw slightcsv_filename_error();
+        }
+    }
+
+    if (!in_base) {
+        in_file.setBufferSize(m_csvp->m_buffer_size);
+        try {
+            in_file.open(m_csvp->m_filename);
+        } catch (const slightinput_open_error &e) {
+            throw slightcsv_filename_error();
+        }
+        in_base = &in_file;
+    }
+
+    // pipes and FIFOs can be read only once
+    t_is_seekable = in_base != &in_file || in_file.getIsSeekable();
+
+    return loadSource(*in_base, m_csvp->m_read_mode == READ_MODE_READ_AHEAD);
+}
+
+bool utils::SlightCSV::loadParallel(void) {
+
+    // rows are passed to a handler in file order, skipped and limited rows depend on the rows before them, data loaded
+    // already determines the header rows, memory mapping and io_uring are explicit choices of the I/O strategy
+    if (m_csvp->m_row_handler || m_csvp->m_row_skip || m_csvp->m_row_limit || m_csvp->m_data_matrix.getRowCount() ||
+        (m_csvp->m_read_mode != READ_MODE_STDIO && m_csvp->m_read_mode != READ_MODE_READ_AHEAD)) {
+        return false;
+    }
+    size_t thread_count = getThreadCountOnline(m_csvp->m_thread_count);
+    if (thread_count < 2) {
+        return false;
+    }
+
+    SlightFileInput in_file;
+    in_file.setBufferSize(m_csvp->m_buffer_size);
+    try {
+        in_file.open(m_csvp->m_filename);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_filename_error();
+    }
+    size_t file_size = in_file.getSize();
+    size_t chunk_count = std::min(thread_count, file_size / m_csvp->m_min_chunk_size);
+    if (!in_file.getIsSeekable() || chunk_count < 2) {
+        return false;
+    }
+
+    SlightChunkJob job;
+    job.m_offsets.resize(chunk_count + 1);
+    try {
+        // offsets of compressed data do not correspond to rows
+        string head = readHead(in_file, RELOAD_HEAD_SIZE);
+        if (SlightDecompressInput::detectFormat(head.data(), head.size()) != SlightDecompressInput::FORMAT_NONE) {
+            return false;
+        }
+        // chunk boundaries are moved to the beginning of the next UTF-8 character (a multibyte escape character is
+        // counted in one chunk)
+        for (size_t i = 1; i < chunk_count; ++i) {
+            size_t offset = (size_t)((double)file_size * i / chunk_count);
+            const char *data;
+            size_t size;
+            in_file.seek(offset);
+            while (in_file.read(data, size)) {
+                size_t skipped = 0;
+                while (skipped < size && ((unsigned char)data[skipped] & 0xc0) == 0x80) {
+                    ++skipped;
+                }
+                offset += skipped;
+                if (skipped < size) {
+                    break;
+                }
+            }
+            job.m_offsets[i] = std::max(offset, job.m_offsets[i - 1]);
+        }
+        job.m_offsets[chunk_count] = file_size;
+    } catch (const slightinput_error &e) {
+        throw slightcsv_read_error();
+    }
+
+    bool is_trimmed = false;
+    job.m_escape_counts.assign(chunk_count, 0);
+    job.m_is_escaped.assign(chunk_count, false);
+    job.m_row_ends.resize(chunk_count);
+    job.m_target = &m_csvp->m_data_matrix;
+    job.m_parsers.assign(chunk_count, 0);
+    job.m_errors.assign(chunk_count, LOAD_OK);
+    pthread_mutex_init(&job.m_mutex, 0);
+    for (size_t i = 0; i < chunk_count; ++i) {
+        job.m_parsers[i] = new SlightCSV;
+        job.m_parsers[i]->copySettings(*this);
+    }
+
+    try {
+        // the escaped state at a chunk boundary is the parity of the escape characters before it (escape characters
+        // toggle the state wherever they are, unless stripped off), they are counted in the chunks in parallel
+        if (m_csvp->m_escape && !m_csvp->m_strip_chars.count(m_csvp->m_escape)) {
+            job.m_phase = CHUNK_COUNT_ESCAPES;
+            job.m_next_index = 0;
+            runThreads(&SlightCSV::loadChunks, &job, chunk_count);
+            for (size_t i = 0; i < chunk_count; ++i) {
+                throwLoadError(job.m_errors[i]);
+            }
+            for (size_t i = 1; i < chunk_count; ++i) {
+                job.m_is_escaped[i] = job.m_is_escaped[i - 1] ^ (job.m_escape_counts[i - 1] & 1);
+            }
+        }
+
+        // the ends of the rows are found in the chunks in parallel and joined into the row index
+        job.m_phase = CHUNK_INDEX_ROWS;
+        job.m_next_index = 0;
+        runThreads(&SlightCSV::loadChunks, &job, chunk_count);
+        size_t row_count = 0;
+        for (size_t i = 0; i < chunk_count; ++i) {
+            throwLoadError(job.m_errors[i]);
+            row_count += job.m_row_ends[i].size();
+        }
+        vector<size_t> &row_index = job.m_row_index;
+        row_index.reserve(row_count);
+        for (size_t i = 0; i < chunk_count; ++i) {
+            row_index.insert(row_index.end(), job.m_row_ends[i].begin(), job.m_row_ends[i].end());
+            vector<size_t>().swap(job.m_row_ends[i]);
+        }
+
+        // the column count is taken from the first row, so the data matrix can be sized before the rows are parsed
+        // (a file without rows is left to the sequential loading)
+        SlightCSV &first = *job.m_parsers[0];
+        bool has_row;
+        try {
+            in_file.seek(0);
+            first.m_csvp->m_cursor_mode = true;
+            first.beginParse(in_file);
+            has_row = first.parseRow();
+            first.m_csvp->m_cursor_mode = false;
+        } catch (const slightinput_error &e) {
+            throw slightcsv_read_error();
+        }
+        in_file.close();
+        if (!has_row || row_index.empty()) {
+            pthread_mutex_destroy(&job.m_mutex);
+            for (size_t i = 0; i < job.m_parsers.size(); ++i) {
+                delete job.m_parsers[i];
+            }
+            return false;
+        }
+        SlightMatrix &target = m_csvp->m_data_matrix;
+        target.reset();
+        target.setColumnCount(first.m_csvp->m_cells.size());
+        target.setRowCount(row_index.size());
+
+        // the rows are split into blocks at the chunk boundaries (rows ending in a chunk), the blocks are parsed in 
+        // parallel into the rows of the data matrix reserved for them
+        job.m_block_rows.assign(chunk_count + 1, row_index.size());
+        for (size_t i = 0; i < chunk_count; ++i) {
+            job.m_block_rows[i] = std::upper_bound(row_index.begin(), row_index.end(), job.m_offsets[i]) - 
+                row_index.begin();
+        }
+        job.m_block_rows[0] = 0;
+        // with a fixed number of header rows or a limited header detection, the header rows are the first rows of the
+        // first block, the other blocks hold data rows only
+        if (m_csvp->m_header_mode == HEADER_MODE_FIXED) {
+            for (size_t i = 1; i < chunk_count; ++i) {
+                job.m_parsers[i]->m_csvp->m_header_mode = HEADER_MODE_NONE;
+            }
+        }
+        job.m_phase = CHUNK_LOAD_ROWS;
+        job.m_next_index = 0;
+        runThreads(&SlightCSV::loadChunks, &job, chunk_count);
+
+        // if the header rows continue beyond the first block (e.g. a short first block), the file is left to the 
+        // sequential loading
+        const SlightCSVPrivate &first_block = *job.m_parsers[0]->m_csvp;
+        bool is_header_open = m_csvp->m_header_mode == HEADER_MODE_FIXED ? 
+            first_block.m_row_id < m_csvp->m_header_row_count : 
+            m_csvp->m_header_mode == HEADER_MODE_DETECT && m_csvp->m_header_row_count && 
+            first_block.m_header_detect_enabled;
+        if (is_header_open && job.m_block_rows[1] < row_index.size() && job.m_errors[0] == LOAD_OK) {
+            target.reset();
+            pthread_mutex_destroy(&job.m_mutex);
+            for (size_t i = 0; i < job.m_parsers.size(); ++i) {
+                delete job.m_parsers[i];
+            }
+            return false;
+        }
+
+        // the first error in file order is reported (header rows must be the first rows of the file, rows of other 
+        // cell counts are reported by the blocks)
+        // (the blocks after a block stopped at an invalid UTF-8 sequence or an error are dropped, the rows before the
+        // error are kept as if the file had been parsed on one thread)
+        size_t header_count = 0;
+        bool headers_only = true;
+        size_t block_count = chunk_count;
+        size_t block_row_id = 0;
+        LoadError error = LOAD_OK;
+        clearUtf8Errors();
+        clearRowErrors();
+        for (size_t i = 0; i < block_count; ++i) {
+            const SlightCSVPrivate &block = *job.m_parsers[i]->m_csvp;
+            if (job.m_block_rows[i] < job.m_block_rows[i + 1]) {
+                size_t block_header_count = block.m_data_matrix.getHeaderCount();
+                if (block_header_count && !headers_only) {
+                    error = LOAD_HEADER_ERROR;
+                    block_count = i;
+                    break;
+                }
+                header_count += block_header_count;
+                headers_only = headers_only && block_header_count == block.m_handled_row_count;
+            }
+            if (job.m_errors[i] != LOAD_OK) {
+                error = job.m_errors[i];
+                block_count = i + 1;
+            }
+            if (job.m_block_rows[i] < job.m_block_rows[i + 1]) {
+                appendUtf8Errors(*job.m_parsers[i]);
+                appendRowErrors(*job.m_parsers[i], block_row_id);
+                block_row_id += block.m_row_id;
+                if (block.m_utf8_failed) {
+                    block_count = i + 1;
+                }
+            }
+        }
+
+        // lines of the row index without cells (e.g. stripped characters or the BOM only) are removed
+        for (size_t i = chunk_count; i-- > 0;) {
+            size_t slot_count = job.m_block_rows[i + 1] - job.m_block_rows[i];
+            size_t block_row_count = i < block_count ? job.m_parsers[i]->m_csvp->m_handled_row_count : 0;
+            if (slot_count && block_row_count < slot_count) {
+                target.removeRows(job.m_block_rows[i] + block_row_count, slot_count - block_row_count);
+            }
+        }
+        target.setHeaderCount(header_count);
+        m_csvp->m_csv_format_detect_done = target.getRowCount() != 0;
+        if (error != LOAD_OK) {
+            is_trimmed = true;
+            throwLoadError(error);
+        }
+
+        // position reached (for incremental reload), as if the file had been parsed on one thread
+        m_csvp->m_row_id = 0;
+        for (size_t i = 0; i < block_count; ++i) {
+            const SlightCSVPrivate &block = *job.m_parsers[i]->m_csvp;
+            if (job.m_block_rows[i] < job.m_block_rows[i + 1]) {
+                m_csvp->m_row_id += block.m_row_id;
+                m_csvp->m_row_end_offset = block.m_row_end_offset;
+                m_csvp->m_tail_row = block.m_tail_row;
+            }
+        }
+        m_csvp->m_row_end_escaped = false;
+        m_csvp->m_bom_found = first.m_csvp->m_bom_found;
+        m_csvp->m_compressed = false;
+        m_csvp->m_stall_time = 0;
+    } catch (...) {
+        // rows reserved for the blocks are not left in the data matrix
+        if (!is_trimmed) {
+            m_csvp->m_data_matrix.reset();
+            m_csvp->m_csv_format_detect_done = false;
+        }
+        pthread_mutex_destroy(&job.m_mutex);
+        for (size_t i = 0; i < job.m_parsers.size(); ++i) {
+            delete job.m_parsers[i];
+        }
+        throw;
+    }
+
+    pthread_mutex_destroy(&job.m_mutex);
+    for (size_t i = 0; i < job.m_parsers.size(); ++i) {
+        delete job.m_parsers[i];
+    }
+
+    return true;
+}
+
+size_t utils::SlightCSV::countEscapes(const size_t t_start, const size_t t_end) {
+    SlightFileInput in_file;
+    in_file.setBufferSize(m_csvp->m_buffer_size);
+    try {
+        in_file.open(m_csvp->m_filename);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_filename_error();
+    }
+
+    // UTF-8 is self-synchronizing, escape characters are matched by their bytes
+    const string escape = m_csvp->m_escape.getString();
+    size_t count = 0;
+    size_t escape_matched = 0;
+    size_t position = t_start;
+    const char *data;
+    size_t size;
+    try {
+        in_file.seek(t_start);
+        while (position < t_end && in_file.read(data, size)) {
+            size = std::min(size, t_end - position);
+            if (escape.size() == 1) {
+                count += std::count(data, data + size, escape[0]);
+            } else {
+                for (const char *in_char = data; in_char != data + size; ++in_char) {
+                    if (*in_char == escape[escape_matched]) {
+                        if (++escape_matched == escape.size()) {
+                            ++count;
+                            escape_matched = 0;
+                        }
+                    } else {
+                        escape_matched = *in_char == escape[0] ? 1 : 0;
+                    }
+                }
+            }
+            position += size;
+        }
+    } catch (const slightinput_error &e) {
+        throw slightcsv_read_error();
+    }
+    return count;
+}
+
+void utils::SlightCSV::indexRows(const size_t t_start, const size_t t_end, const bool t_is_escaped, 
+    vector<size_t> &t_row_ends) {
+    SlightFileInput in_file;
+    in_file.setBufferSize(m_csvp->m_buffer_size);
+    try {
+        in_file.open(m_csvp->m_filename);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_filename_error();
+    }
+
+    // new line characters are row boundaries unless stripped off or escaped, the scanner skips the bytes between them
+    // (escaped regions included)
+    const bool cr_is_boundary = !m_csvp->m_strip_chars.count(U8_CR);
+    const bool nl_is_boundary = !m_csvp->m_strip_chars.count(U8_NL);
+    SlightScanner scanner;
+    if (cr_is_boundary) {
+        scanner.addTarget('\r');
+    }
+    if (nl_is_boundary) {
+        scanner.addTarget('\n');
+    }
+    if (m_csvp->m_escape && !m_csvp->m_strip_chars.count(m_csvp->m_escape)) {
+        scanner.setEscape(m_csvp->m_escape.getByte(0));
+    }
+
+    // the end of a row is the end of the first boundary after a non-empty line, the byte before the chunk tells if the
+    // chunk begins with a new line (new line characters do not change the escaped state)
+    bool is_escaped = t_is_escaped;
+    bool is_first = t_start != 0;
+    size_t line_start = t_start ? (size_t)-1 : 0;
+    size_t position = t_start ? t_start - 1 : 0;
+    const char *data;
+    size_t size;
+    try {
+        in_file.seek(position);
+        while (position < t_end && in_file.read(data, size)) {
+            size = std::min(size, t_end - position);
+            size_t i = 0;
+            if (is_first) {
+                if (!is_escaped && ((data[0] == '\r' && cr_is_boundary) || (data[0] == '\n' && nl_is_boundary))) {
+                    line_start = t_start;
+                }
+                is_first = false;
+                i = 1;
+            }
+            // bytes of multibyte characters are reported by the scanner as well
+            while ((i += scanner.find(data + i, size - i, is_escaped)) < size) {
+                if (data[i] == '\r' || data[i] == '\n') {
+                    if (position + i != line_start) {
+                        t_row_ends.push_back(position + i + 1);
+                    }
+                    line_start = position + i + 1;
+                }
+                ++i;
+            }
+            position += size;
+        }
+        // the last row of the file may not be terminated by a new line
+        if (position == in_file.getSize() && position != line_start) {
+            t_row_ends.push_back(position);
+        }
+    } catch (const slightinput_error &e) {
+        throw slightcsv_read_error();
+    }
+
+    in_file.close();
+}
+
+void utils::SlightCSV::loadChunk(const size_t t_start, const size_t t_end, SlightMatrix &t_target, 
+    const size_t t_first_row) {
+    SlightFileInput in_file;
+    in_file.setBufferSize(m_csvp->m_buffer_size);
+    try {
+        in_file.open(m_csvp->m_filename);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_filename_error();
+    }
+
+    try {
+        beginParse(in_file);
+        // blocks other than the first begin at a row boundary, not escaped, with row ids counted from zero (headers
+        // are recognized at the beginning of the block, the caller checks that they are the first rows of the file)
+        if (t_start) {
+            in_file.seek(t_start);
+            resumeParse(in_file, t_start, 0, false);
+            m_csvp->m_bom_found = true;
+        }
+        // the rows are written into the target from the given row on, their cell count is known already
+        m_csvp->m_data_matrix.setColumnCount(t_target.getColumnCount());
+        m_csvp->m_csv_format_detect_done = true;
+        m_csvp->m_slot_matrix = &t_target;
+        m_csvp->m_slot_row = t_first_row;
+        m_csvp->m_range_end = t_end;
+        while (parseRow()) {
+        }
+    } catch (const slightinput_error &e) {
+        m_csvp->m_slot_matrix = 0;
+        throw slightcsv_read_error();
+    } catch (...) {
+        m_csvp->m_slot_matrix = 0;
+        throw;
+    }
+
+    m_csvp->m_slot_matrix = 0;
+    in_file.close();
+}
+
+size_t utils::SlightCSV::loadData(const char *t_data, const size_t t_size) {
+
+    if (!m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    m_csvp->m_reload_valid = false;
+
+    SlightMemoryInput in_memory;
+    try {
+        in_memory.open(t_data, t_size);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_buffer_error();
+    }
+    return loadSource(in_memory, false);
+}
+
+size_t utils::SlightCSV::loadData(FILE *t_file) {
+    SlightStreamInput in_stream;
+    try {
+        in_stream.open(t_file);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_stream_error();
+    }
+    return loadStream(in_stream);
+}
+
+size_t utils::SlightCSV::loadData(const int t_fd) {
+    SlightStreamInput in_stream;
+    try {
+        in_stream.open(t_fd);
+    } catch (const slightinput_error &e) {
+        throw slightcsv_stream_error();
+    }
+    return loadStream(in_stream);
+}
+
+size_t utils::SlightCSV::loadData(std::istream &t_stream) {
+    SlightStreamInput in_stream;
+    try {
+        in_stream.open(t_stream);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_stream_error();
+    }
+    return loadStream(in_stream);
+}
+
+size_t utils::SlightCSV::loadStream(SlightStreamInput &t_stream) {
+
+    if (!m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    m_csvp->m_reload_valid = false;
+
+    // mmap and io_uring need a regular file, streams are read with plain reads (or on the I/O thread)
+    t_stream.setBufferSize(m_csvp->m_buffer_size);
+    return loadSource(t_stream, m_csvp->m_read_mode == READ_MODE_READ_AHEAD);
+}
+
+size_t utils::SlightCSV::loadData(const vector<string> &t_filenames) {
+
+    if (!t_filenames.size()) {
+        throw slightcsv_filename_error();
+    }
+
+    if (!m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    m_csvp->m_reload_valid = false;
+
+    // in streaming mode, files are parsed one after another (rows are passed to the handler in order)
+    if (m_csvp->m_row_handler) {
+        SlightMultiFileHandler handler;
+        handler.m_target = m_csvp->m_row_handler;
+        handler.m_cell_count = 0;
+        handler.m_row_count = 0;
+        size_t header_count = 0;
+        // skip and limit apply to the data rows of the files together, each file skips and limits the rest of them
+        size_t row_skip = m_csvp->m_row_skip;
+        size_t row_limit = m_csvp->m_row_limit;
+        clearUtf8Errors();
+        clearRowErrors();
+        for (size_t i = 0; i < t_filenames.size(); ++i) {
+            SlightCSV parser;
+            parser.copySettings(*this);
+            parser.m_csvp->m_row_skip = row_skip;
+            parser.m_csvp->m_row_limit = row_limit;
+            parser.setFileName(t_filenames[i]);
+            parser.setRowHandler(&handler);
+            handler.m_file_index = i;
+            handler.m_header_count = 0;
+            parser.loadData();
+            if (i && handler.m_header_count != header_count) {
+                throw slightcsv_format_header_error();
+            }
+            header_count = handler.m_header_count;
+            // loading stops at a file stopped at an invalid UTF-8 sequence
+            appendUtf8Errors(parser);
+            appendRowErrors(parser, 0);
+            if (parser.m_csvp->m_utf8_failed) {
+                break;
+            }
+            // no more files are read once the limit is reached
+            size_t data_row_count = parser.m_csvp->m_data_row_count;
+            size_t skipped_count = std::min(row_skip, data_row_count);
+            row_skip -= skipped_count;
+            if (row_limit) {
+                row_limit -= std::min(row_limit, data_row_count - skipped_count);
+                if (!row_limit) {
+                    break;
+                }
+            }
+        }
+        m_csvp->m_handled_row_count = handler.m_row_count;
+        return handler.m_row_count;
+    }
+
+    // parse the files on a pool of threads, each file into its own data matrix
+    SlightLoadJob job;
+    job.m_filenames = &t_filenames;
+    job.m_parsers.assign(t_filenames.size(), 0);
+    job.m_errors.assign(t_filenames.size(), LOAD_OK);
+    job.m_next_index = 0;
+    // skip and limit apply to the data rows of the files together (in the merge), a file holds no more data rows 
+    // than the ones skipped and limited
+    job.m_row_goal = m_csvp->m_row_limit ? m_csvp->m_row_skip + m_csvp->m_row_limit : 0;
+    job.m_loaded.assign(t_filenames.size(), false);
+    job.m_data_rows.assign(t_filenames.size(), 0);
+    job.m_goal_reached = false;
+    pthread_mutex_init(&job.m_mutex, 0);
+    for (size_t i = 0; i < t_filenames.size(); ++i) {
+        job.m_parsers[i] = new SlightCSV;
+        job.m_parsers[i]->copySettings(*this);
+        // the files are loaded concurrently already, each of them is parsed on a single thread
+        job.m_parsers[i]->m_csvp->m_thread_count = 1;
+        job.m_parsers[i]->m_csvp->m_row_skip = 0;
+        job.m_parsers[i]->m_csvp->m_row_limit = job.m_row_goal;
+    }
+
+    size_t thread_count = std::min(getThreadCountOnline(m_csvp->m_thread_count), t_filenames.size());
+
+    // the calling thread loads files as well
+    runThreads(&SlightCSV::loadFiles, &job, std::max((size_t)1, thread_count));
+    pthread_mutex_destroy(&job.m_mutex);
+
+    // merge the results in file order (the first error in file order is reported, the files after a file stopped at 
+    // an invalid UTF-8 sequence are dropped)
+    try {
+        size_t cell_count = 0;
+        size_t file_count = t_filenames.size();
+        size_t first_index = t_filenames.size();
+        size_t row_skip = m_csvp->m_row_skip;
+        size_t row_limit = m_csvp->m_row_limit;
+        clearUtf8Errors();
+        clearRowErrors();
+        for (size_t i = 0; i < file_count; ++i) {
+            throwLoadError(job.m_errors[i]);
+            appendUtf8Errors(*job.m_parsers[i]);
+            appendRowErrors(*job.m_parsers[i], 0);
+            if (job.m_parsers[i]->m_csvp->m_utf8_failed) {
+                file_count = i + 1;
+            }
+            SlightMatrix &matrix = job.m_parsers[i]->m_csvp->m_data_matrix;
+            if (!matrix.getRowCount()) {
+                continue;
+            }
+            if (first_index == t_filenames.size()) {
+                first_index = i;
+            }
+            const SlightMatrix &first = job.m_parsers[first_index]->m_csvp->m_data_matrix;
+            if (matrix.getColumnCount() != first.getColumnCount()) {
+                throw slightcsv_format_cellcnt_error();
+            }
+            if (matrix.getHeaderCount() != first.getHeaderCount()) {
+                throw slightcsv_format_header_error();
+            }
+            // skipped data rows are removed, the files after the one reaching the limit are dropped
+            size_t data_row_count = matrix.getRowCount() - matrix.getHeaderCount();
+            size_t skipped_count = std::min(row_skip, data_row_count);
+            if (skipped_count) {
+                matrix.removeRows(matrix.getHeaderCount(), skipped_count);
+                row_skip -= skipped_count;
+                data_row_count -= skipped_count;
+            }
+            if (row_limit) {
+                size_t kept_count = std::min(row_limit, data_row_count);
+                matrix.removeRows(data_row_count - kept_count);
+                row_limit -= kept_count;
+                if (!row_limit) {
+                    file_count = i + 1;
+                }
+            }
+            cell_count += matrix.getRowCount() * matrix.getColumnCount();
+        }
+
+        SlightMatrix &target = m_csvp->m_data_matrix;
+        if (first_index < t_filenames.size()) {
+            const SlightMatrix &first = job.m_parsers[first_index]->m_csvp->m_data_matrix;
+            bool has_data = target.getRowCount() > 0;
+            if (has_data && target.getColumnCount() != first.getColumnCount()) {
+                throw slightcsv_format_cellcnt_error();
+            }
+            if (!has_data) {
+                target.reset();
+                target.setColumnCount(first.getColumnCount());
+                target.setHeaderCount(first.getHeaderCount());
+                m_csvp->m_csv_format_detect_done = true;
+            }
+            target.setCapacity(target.getRowCount() * target.getColumnCount() + cell_count);
+            for (size_t i = first_index; i < file_count; ++i) {
+                SlightMatrix &matrix = job.m_parsers[i]->m_csvp->m_data_matrix;
+                // header rows are taken from the first file only (unless data is loaded already)
+                target.appendRows(matrix, i == first_index && !has_data ? 0 : matrix.getHeaderCount());
+            }
+        }
+    } catch (...) {
+        for (size_t i = 0; i < job.m_parsers.size(); ++i) {
+            delete job.m_parsers[i];
+        }
+        throw;
+    }
+
+    for (size_t i = 0; i < job.m_parsers.size(); ++i) {
+        delete job.m_parsers[i];
+    }
+
+    return m_csvp->m_data_matrix.getRowCount();
+}
+
+size_t utils::SlightCSV::loadDataGlob(const string &t_pattern) {
+    vector<string> filenames;
+#ifndef _WIN32
+    glob_t glob_result;
+    if (glob(t_pattern.c_str(), 0, 0, &glob_result) == 0) {
+        filenames.assign(glob_result.gl_pathv, glob_result.gl_pathv + glob_result.gl_pathc);
+    }
+    globfree(&glob_result);
+#endif
+    // no files matching
+    if (!filenames.size()) {
+        throw slightcsv_filename_error();
+    }
+    return loadData(filenames);
+}
+
+void *utils::SlightCSV::loadFiles(void *t_job) {
+    SlightLoadJob &job = *static_cast<SlightLoadJob*>(t_job);
+    while (true) {
+        // take the next file
+        pthread_mutex_lock(&job.m_mutex);
+        size_t index = job.m_next_index++;
+        bool goal_reached = job.m_goal_reached;
+        pthread_mutex_unlock(&job.m_mutex);
+        if (index >= job.m_filenames->size() || goal_reached) {
+            return 0;
+        }
+        SlightCSV &parser = *job.m_parsers[index];
+        try {
+            parser.setFileName((*job.m_filenames)[index]);
+            parser.loadData();
+        } catch (...) {
+            job.m_errors[index] = getLoadError();
+        }
+        // with a row limit, check whether the files loaded in file order hold the rows needed
+        if (job.m_row_goal) {
+            const SlightMatrix &matrix = parser.m_csvp->m_data_matrix;
+            pthread_mutex_lock(&job.m_mutex);
+            job.m_loaded[index] = true;
+            job.m_data_rows[index] = matrix.getRowCount() - std::min(matrix.getRowCount(), matrix.getHeaderCount());
+            size_t row_count = 0;
+            for (size_t i = 0; i < job.m_loaded.size() && job.m_loaded[i]; ++i) {
+                row_count += job.m_data_rows[i];
+            }
+            job.m_goal_reached = job.m_goal_reached || row_count >= job.m_row_goal;
+            pthread_mutex_unlock(&job.m_mutex);
+        }
+    }
+}
+
+void *utils::SlightCSV::loadChunks(void *t_job) {
+    SlightChunkJob &job = *static_cast<SlightChunkJob*>(t_job);
+    while (true) {
+        // take the next chunk
+        pthread_mutex_lock(&job.m_mutex);
+        size_t index = job.m_next_index++;
+        pthread_mutex_unlock(&job.m_mutex);
+        if (index >= job.m_parsers.size()) {
+            return 0;
+        }
+        try {
+            SlightCSV &parser = *job.m_parsers[index];
+            size_t first_row = job.m_block_rows.empty() ? 0 : job.m_block_rows[index];
+            switch (job.m_phase) {
+                case CHUNK_COUNT_ESCAPES:
+                    job.m_escape_counts[index] = parser.countEscapes(job.m_offsets[index], job.m_offsets[index + 1]);
+                    break;
+                case CHUNK_INDEX_ROWS:
+                    parser.indexRows(job.m_offsets[index], job.m_offsets[index + 1], job.m_is_escaped[index], 
+                        job.m_row_ends[index]);
+                    break;
+                case CHUNK_LOAD_ROWS:
+                    // a block begins at the end of the row before its first row
+                    if (first_row < job.m_block_rows[index + 1]) {
+                        parser.loadChunk(first_row ? job.m_row_index[first_row - 1] : 0, 
+                            job.m_row_index[job.m_block_rows[index + 1] - 1], *job.m_target, first_row);
+                    }
+                    break;
+            }
+        } catch (...) {
+            job.m_errors[index] = getLoadError();
+        }
+    }
+}
+
+void utils::SlightCSV::copySettings(const SlightCSV &t_source) {
+    m_csvp->m_filename = t_source.m_csvp->m_filename;
+    m_csvp->m_separator = t_source.m_csvp->m_separator;
+    m_csvp->m_escape = t_source.m_csvp->m_escape;
+    m_csvp->m_strip_chars = t_source.m_csvp->m_strip_chars;
+    m_csvp->m_rep_chars = t_source.m_csvp->m_rep_chars;
+    m_csvp->m_read_mode = t_source.m_csvp->m_read_mode;
+    m_csvp->m_buffer_size = t_source.m_csvp->m_buffer_size;
+    m_csvp->m_buffer_count = t_source.m_csvp->m_buffer_count;
+    m_csvp->m_thread_count = t_source.m_csvp->m_thread_count;
+    m_csvp->m_min_chunk_size = t_source.m_csvp->m_min_chunk_size;
+    m_csvp->m_row_skip = t_source.m_csvp->m_row_skip;
+    m_csvp->m_row_limit = t_source.m_csvp->m_row_limit;
+    m_csvp->m_empty_cell_mode = t_source.m_csvp->m_empty_cell_mode;
+    m_csvp->m_header_mode = t_source.m_csvp->m_header_mode;
+    m_csvp->m_header_row_count = t_source.m_csvp->m_header_row_count;
+    m_csvp->m_utf8_policy = t_source.m_csvp->m_utf8_policy;
+    m_csvp->m_utf8_validation = t_source.m_csvp->m_utf8_validation;
+    m_csvp->m_row_policy = t_source.m_csvp->m_row_policy;
+    // row object holds delimiter and escape character as well
+    m_csvp->m_row = t_source.m_csvp->m_row;
+    m_csvp->m_row.clear();
+}
+
+size_t utils::SlightCSV::loadSource(SlightInput &t_source, const bool t_read_ahead) {
+
+    // compressed sources are detected by their magic bytes
+    SlightDecompressInput in_decompress;
+    in_decompress.setBufferSize(m_csvp->m_buffer_size);
+    try {
+        in_decompress.open(t_source);
+    } catch (const slightinput_unsupported_error &e) {
+        throw slightcsv_compression_error();
+    } catch (const slightinput_error &e) {
+        throw slightcsv_read_error();
+    }
+    m_csvp->m_compressed = in_decompress.getFormat() != SlightDecompressInput::FORMAT_NONE;
+
+    // decompression is done on the I/O thread, so it overlaps with parsing
+    if (t_read_ahead || m_csvp->m_compressed) {
+        SlightReadAheadInput in_read_ahead;
+        in_read_ahead.setBufferCount(m_csvp->m_buffer_count);
+        try {
+            in_read_ahead.open(in_decompress);
+        } catch (const slightinput_open_error &e) {
+            throw slightcsv_read_error();
+        }
+        size_t retval = loadInput(in_read_ahead);
+        m_csvp->m_stall_time = in_read_ahead.getStallTime();
+        return retval;
+    }
+
+    return loadInput(in_decompress);
+}
+
+size_t utils::SlightCSV::loadInput(SlightInput &t_input) {
+
+    size_t retval = 0;
+
+    beginParse(t_input);
+
+    // parse the input row by row
+    while (parseRow()) {
+    }
+
+    t_input.close();
+
+    // set return value (number if rows processed)
+    if (m_csvp->m_row_handler) {
+        retval = m_csvp->m_handled_row_count;
+    } else {
+        retval = m_csvp->m_data_matrix.getRowCount();
+    }
+
+    return retval;
+}
+
+void utils::SlightCSV::beginParse(SlightInput &t_input) {
+    // set up parser state
+    m_csvp->m_in_u8_char.clear();
+    m_csvp->m_in_line.clear();
+    m_csvp->m_is_escaped = false;
+    m_csvp->m_row_id = 0;
+    m_csvp->m_bom_found = false;
+    m_csvp->m_handled_row_count = 0;
+    m_csvp->m_stall_time = 0;
+    m_csvp->m_input = &t_input;
+    m_csvp->m_chunk = 0;
+    m_csvp->m_chunk_size = 0;
+    m_csvp->m_chunk_offset = 0;
+    m_csvp->m_chunk_base = 0;
+    m_csvp->m_row_end_offset = 0;
+    m_csvp->m_row_end_escaped = false;
+    m_csvp->m_tail_row = false;
+    m_csvp->m_range_end = 0;
+    m_csvp->m_parse_done = false;
+    m_csvp->m_row_started = false;
+    m_csvp->m_headers_only = false;
+    m_csvp->m_data_row_count = 0;
+    m_csvp->m_row_skipped = false;
+    m_csvp->m_row_limits_active = m_csvp->m_row_skip || m_csvp->m_row_limit;
+    m_csvp->m_header_detect_enabled = m_csvp->m_header_mode == HEADER_MODE_DETECT;
+    clearUtf8Errors();
+    clearRowErrors();
+    m_csvp->m_row_text.clear();
+    m_csvp->m_row_text_offset = 0;
+    setupTables();
+
+    // if no data is loaded (e.g. after streaming), detect the format again
+    if (!m_csvp->m_data_matrix.getRowCount()) {
+        m_csvp->m_data_matrix.reset();
+        m_csvp->m_csv_format_detect_done = false;
+    }
+
+    // get input size in order to support resource allocation (row count not known in advance)
+    m_csvp->m_file_size = t_input.getSize();
+}
+
+void utils::SlightCSV::setupTables(void) {
+    m_csvp->m_dfa_enabled = m_csvp->m_dfa.setupRows(m_csvp->m_escape, m_csvp->m_strip_chars, m_csvp->m_rep_chars);
+    // rows are split into cells while parsing if both machines can be used and the escaped state of the cells follows
+    // the escaped state of the row, otherwise lines are collected and processed by the row object
+    m_csvp->m_fused_enabled = m_csvp->m_dfa_enabled && 
+        m_csvp->m_cell_dfa.setupCells(m_csvp->m_separator, m_csvp->m_escape) && 
+        !isEscapeReplaced(m_csvp->m_escape, m_csvp->m_rep_chars);
+    m_csvp->m_scan_enabled = setupScanner(m_csvp->m_scanner, m_csvp->m_fused_enabled ? m_csvp->m_separator : U8char(),
+        m_csvp->m_escape, m_csvp->m_strip_chars, m_csvp->m_rep_chars);
+    // multibyte characters of valid input can be copied with the runs if none of them has to be looked at (no
+    // multibyte escape character, strip or replace rules)
+    m_csvp->m_text_scanner = m_csvp->m_scanner;
+    m_csvp->m_text_scanner.setMultibyteStop(false);
+    m_csvp->m_text_scan_enabled = m_csvp->m_scan_enabled && m_csvp->m_dfa_enabled && 
+        !m_csvp->m_dfa.hasMultibyteRules() && m_csvp->m_escape.size() <= 1;
+    m_csvp->m_trusted_begin = 0;
+    m_csvp->m_trusted_end = 0;
+    // common dialects are parsed by specializations comparing bytes with constants
+    m_csvp->m_dialect_parser = 0;
+    if (m_csvp->m_fused_enabled && m_csvp->m_scan_enabled && m_csvp->m_strip_chars.empty() && 
+        m_csvp->m_rep_chars.empty()) {
+        char separator = m_csvp->m_separator.getByte(0);
+        char escape = m_csvp->m_escape ? m_csvp->m_escape.getByte(0) : 0;
+        if (separator == ',' && escape == '"') {
+            m_csvp->m_dialect_parser = &SlightCSV::parseDialect<',', '"'>;
+        } else if (separator == ';' && escape == '"') {
+            m_csvp->m_dialect_parser = &SlightCSV::parseDialect<';', '"'>;
+        } else if (separator == '\t' && escape == '"') {
+            m_csvp->m_dialect_parser = &SlightCSV::parseDialect<'\t', '"'>;
+        } else if (separator == ',' && !escape) {
+            m_csvp->m_dialect_parser = &SlightCSV::parseDialect<',', 0>;
+        } else if (separator == ';' && !escape) {
+            m_csvp->m_dialect_parser = &SlightCSV::parseDialect<';', 0>;
+        } else if (separator == '\t' && !escape) {
+            m_csvp->m_dialect_parser = &SlightCSV::parseDialect<'\t', 0>;
+        }
+    }
+    m_csvp->m_cell_state = SlightDfa::STATE_EMPTY;
+    m_csvp->m_cell_index = 0;
+    m_csvp->m_row_size = 0;
+    m_csvp->m_digit_count = 0;
+}
+
+size_t utils::SlightCSV::loadDataRange(const size_t t_offset, const size_t t_length) {
+
+    if (!m_csvp->m_filename.size()) {
+        throw slightcsv_filename_error();
+    }
+
+    if (!m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    if (!t_length) {
+        throw slightcsv_range_error();
+    }
+
+    m_csvp->m_reload_valid = false;
+
+    SlightFileInput in_file;
+    in_file.setBufferSize(m_csvp->m_buffer_size);
+    try {
+        in_file.open(m_csvp->m_filename);
+    } catch (const slightinput_open_error &e) {
+        throw slightcsv_filename_error();
+    }
+
+    try {
+        // offsets of compressed data do not correspond to rows
+        string head = readHead(in_file, RELOAD_HEAD_SIZE);
+        if (SlightDecompressInput::detectFormat(head.data(), head.size()) != SlightDecompressInput::FORMAT_NONE) {
+            throw slightcsv_compression_error();
+        }
+        in_file.seek(0);
+
+        beginParse(in_file);
+        // the capacity estimate is based on the range length
+        m_csvp->m_file_size = t_length;
+
+        if (t_offset) {
+            // load the header rows from the beginning of the file
+            m_csvp->m_headers_only = true;
+            while (parseRow()) {
+            }
+            size_t start = m_csvp->m_row_end_offset;
+            size_t handled_row_count = m_csvp->m_handled_row_count;
+
+            // find the first row boundary of the range
+            if (t_offset > start) {
+                in_file.seek(start);
+                start = findRowStart(in_file, start, t_offset, false);
+            }
+            in_file.seek(std::min(start, in_file.getSize()));
+            resumeParse(in_file, start, m_csvp->m_data_matrix.getHeaderCount(), false);
+            m_csvp->m_handled_row_count = handled_row_count;
+            m_csvp->m_file_size = t_length;
+        }
+
+        // parse rows beginning within the range (guard against overflow of the end offset)
+        m_csvp->m_range_end = t_length > (size_t)-1 - t_offset ? (size_t)-1 : t_offset + t_length;
+        while (parseRow()) {
+        }
+    } catch (const slightinput_error &e) {
+        throw slightcsv_read_error();
+    }
+
+    in_file.close();
+
+    // set return value (number of rows processed)
+    if (m_csvp->m_row_handler) {
+        return m_csvp->m_handled_row_count;
+    }
+    return m_csvp->m_data_matrix.getRowCount();
+}
+
+void utils::SlightCSV::resumeParse(SlightInput &t_input, const size_t t_offset, const size_t t_row_id, 
+    const bool t_is_escaped) {
+    // continue from a row boundary (the input is positioned there), with the state reached there (loaded data and the
+    // detected format are kept)
+    m_csvp->m_in_u8_char.clear();
+    m_csvp->m_in_line.clear();
+    m_csvp->m_is_escaped = t_is_escaped;
+    m_csvp->m_row_id = t_row_id;
+    m_csvp->m_handled_row_count = 0;
+    m_csvp->m_stall_time = 0;
+    m_csvp->m_input = &t_input;
+    m_csvp->m_chunk = 0;
+    m_csvp->m_chunk_size = 0;
+    m_csvp->m_chunk_offset = 0;
+    m_csvp->m_chunk_base = t_offset;
+    m_csvp->m_row_end_offset = t_offset;
+    m_csvp->m_row_end_escaped = t_is_escaped;
+    m_csvp->m_tail_row = false;
+    m_csvp->m_range_end = 0;
+    m_csvp->m_parse_done = false;
+    m_csvp->m_row_started = false;
+    m_csvp->m_headers_only = false;
+    m_csvp->m_row_skipped = false;
+    // resumed parsing continues in the data section, rows are checked only if every row is
+    m_csvp->m_header_detect_enabled = m_csvp->m_header_mode == HEADER_MODE_DETECT && !m_csvp->m_header_row_count;
+    clearUtf8Errors();
+    clearRowErrors();
+    m_csvp->m_row_text.clear();
+    m_csvp->m_row_text_offset = t_offset;
+    setupTables();
+    m_csvp->m_file_size = t_input.getSize() - t_offset;
 }
 
-void utils::SlightCSV::setStripChars(const set<string> &t_strip_chars) {
-    if (!t_strip_chars.size()) {
-        throw slightcsv_strip_error();
+size_t utils::SlightCSV::findRowStart(SlightInput &t_input, const size_t t_position, const size_t t_offset, 
+    const bool t_is_escaped) {
+    // new line characters are row boundaries unless stripped off or escaped
+    const bool cr_is_boundary = !m_csvp->m_strip_chars.count(U8_CR);
+    const bool nl_is_boundary = !m_csvp->m_strip_chars.count(U8_NL);
+    string escape;
+    if (m_csvp->m_escape && !m_csvp->m_strip_chars.count(m_csvp->m_escape)) {
+        escape = m_csvp->m_escape.getString();
     }
-    // convert string set to U8char set
-    set<U8char> u8_strip_chars;
-    // iterate through set
-    for (set<string>::const_iterator it = t_strip_chars.begin(); it != t_strip_chars.end(); ++it) {
-        // try to create U8char from character supplied as string
-        U8char u8c;
-        try {
-            u8c = (*it).c_str();
-        } catch (const u8char_format_error &e) {
-            // conversion failed because of invalid string input
-            throw slightcsv_strip_error();
+    const size_t escape_size = escape.size();
+
+    // scan bytes (UTF-8 is self-synchronizing, characters can be matched by their bytes), the escape state is kept by
+    // counting escape characters from the position (with the escaped state there)
+    bool is_escaped = t_is_escaped;
+    size_t escape_matched = 0;
+    size_t position = t_position;
+    const char *data;
+    size_t size;
+    while (t_input.read(data, size)) {
+        for (const char *in_char = data; in_char != data + size; ++in_char, ++position) {
+            if (escape_size) {
+                if (*in_char == escape[escape_matched]) {
+                    if (++escape_matched == escape_size) {
+                        is_escaped ^= true;
+                        escape_matched = 0;
+                    }
+                    continue;
+                }
+                escape_matched = *in_char == escape[0] ? 1 : 0;
+            }
+            // the first boundary ending at or after the offset (a row starting exactly at the offset is included)
+            if (position + 1 >= t_offset && !is_escaped && 
+                ((*in_char == '\n' && nl_is_boundary) || (*in_char == '\r' && cr_is_boundary))) {
+                return position + 1;
+            }
         }
-        // insert converted U8char into set
-        u8_strip_chars.insert(u8c);
     }
-    m_csvp->m_strip_chars = u8_strip_chars;
+    return position;
 }
 
-void utils::SlightCSV::getStripChars(set<string> &t_target) const {
-    if (!m_csvp->m_strip_chars.size()) {
-        throw slightcsv_strip_error();
-    }
-    t_target.clear();
-    // convert U8char set to string set
-    for (set<U8char>::const_iterator it = m_csvp->m_strip_chars.begin(); it != m_csvp->m_strip_chars.end(); ++it) {
-        t_target.insert((*it).getString());
-    }
+void utils::SlightCSV::saveReloadState(void) {
+    m_csvp->m_reload_offset = m_csvp->m_row_end_offset;
+    m_csvp->m_reload_row_id = m_csvp->m_tail_row ? m_csvp->m_row_id - 1 : m_csvp->m_row_id;
+    m_csvp->m_reload_escaped = m_csvp->m_row_end_escaped;
+    m_csvp->m_reload_bom_found = m_csvp->m_bom_found;
+    m_csvp->m_reload_tail = m_csvp->m_tail_row;
+    m_csvp->m_reload_valid = true;
 }
 
-void utils::SlightCSV::setReplaceChars(const map<string, string> &t_rep_chars) {
-    if (!t_rep_chars.size()) {
-        throw slightcsv_replace_error();
+size_t utils::SlightCSV::reloadData(void) {
+
+    if (!m_csvp->m_filename.size()) {
+        throw slightcsv_filename_error();
     }
-    // convert string map to U8char map
-    map<U8char, U8char> u8_rep_chars;
-    // iterate through map
-    for (map<string, string>::const_iterator it = t_rep_chars.begin(); it != t_rep_chars.end(); ++it) {
-        pair<U8char, U8char> p;
-        // try to create U8chars from characters supplied as strings
+
+    if (!m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    SlightFileInput in_file;
+    in_file.setBufferSize(m_csvp->m_buffer_size);
+    bool resumable = m_csvp->m_reload_valid && m_csvp->m_reload_filename == m_csvp->m_filename;
+    if (resumable) {
         try {
-            p.first = U8char((*it).first.c_str());
-            p.second = U8char((*it).second.c_str());
-        } catch (const u8char_format_error &e) {
-            // conversion failed because of invalid string input
-            throw slightcsv_replace_error();
+            in_file.open(m_csvp->m_filename);
+            // a truncated or replaced (rotated) file is loaded from the beginning
+            resumable = in_file.getFileId() == m_csvp->m_reload_file_id && 
+                in_file.getSize() >= m_csvp->m_reload_offset && 
+                readHead(in_file, m_csvp->m_reload_head.size()) == m_csvp->m_reload_head;
+            if (resumable) {
+                in_file.seek(m_csvp->m_reload_offset);
+            }
+        } catch (const slightinput_open_error &e) {
+            throw slightcsv_filename_error();
+        } catch (const slightinput_error &e) {
+            throw slightcsv_read_error();
         }
-        // insert converted pair into map
-        u8_rep_chars.insert(p);
     }
-    m_csvp->m_rep_chars = u8_rep_chars;
-}
 
-void utils::SlightCSV::getReplaceChars(map<string, string> &t_target) const {
-    if (!m_csvp->m_rep_chars.size()) {
-        throw slightcsv_replace_error();
+    if (!resumable) {
+        in_file.close();
+        m_csvp->m_data_matrix.reset();
+        m_csvp->m_csv_format_detect_done = false;
+        m_csvp->m_row.clear();
+        return loadData();
     }
-    t_target.clear();
-    // convert U8char map to string map
-    for(map<U8char, U8char>::const_iterator it = m_csvp->m_rep_chars.begin(); it != m_csvp->m_rep_chars.end(); ++it) {
-        pair<string, string> p((*it).first.getString(), (*it).second.getString());
-        t_target.insert(p);
+
+    // an unterminated last row is parsed again, as it may have been continued
+    if (m_csvp->m_reload_tail && !m_csvp->m_row_handler && m_csvp->m_data_matrix.getRowCount()) {
+        m_csvp->m_data_matrix.removeRows(1);
     }
-}
+    size_t row_count = m_csvp->m_data_matrix.getRowCount();
 
-size_t utils::SlightCSV::loadData(void) {
+    m_csvp->m_reload_valid = false;
+    resumeParse(in_file, m_csvp->m_reload_offset, m_csvp->m_reload_row_id, m_csvp->m_reload_escaped);
+    m_csvp->m_bom_found = m_csvp->m_reload_bom_found;
+    // appended rows are loaded without skip and limit
+    m_csvp->m_row_limits_active = false;
 
-    if (!m_csvp->m_filename.size()) {
-        throw slightcsv_filename_error();
+    // parse the appended rows
+    while (parseRow()) {
     }
 
-    if (!m_csvp->m_separator) {
-        throw slightcsv_separator_error();
+    in_file.close();
+    saveReloadState();
+
+    // set return value (number of rows processed)
+    if (m_csvp->m_row_handler) {
+        return m_csvp->m_handled_row_count;
     }
+    return m_csvp->m_data_matrix.getRowCount() - row_count;
+}
 
-    size_t retval = 0;
+bool utils::SlightCSV::parseRow(void) {
 
-    // open file for processing
-    FILE *in_file = fopen(m_csvp->m_filename.c_str(), "rb");
-    if (!in_file) {
-        throw slightcsv_filename_error();
+    // parse input chunks until a row is submitted for processing (or parsing is stopped)
+    while (m_csvp->m_input && !m_csvp->m_parse_done) {
+        // if current chunk is consumed, get next one
+        if (m_csvp->m_chunk_offset == m_csvp->m_chunk_size) {
+            bool has_chunk;
+            // the beginning of a row continuing in the next chunk is kept in case the row is malformed
+            if (m_csvp->m_row_policy == ROW_POLICY_QUARANTINE) {
+                keepRowText();
+            }
+            // keep track of the input position of the chunk
+            m_csvp->m_chunk_base += m_csvp->m_chunk_size;
+            m_csvp->m_chunk_size = 0;
+            m_csvp->m_chunk_offset = 0;
+            try {
+                has_chunk = m_csvp->m_input->read(m_csvp->m_chunk, m_csvp->m_chunk_size);
+            } catch (const slightinput_read_error &e) {
+                m_csvp->m_input = 0;
+                throw slightcsv_read_error();
+            }
+            if (!has_chunk) {
+                break;
+            }
+            // the chunk is validated at once, except the characters split between chunks (assembled byte by byte)
+            m_csvp->m_trusted_begin = 0;
+            m_csvp->m_trusted_end = 0;
+            if (m_csvp->m_text_scan_enabled) {
+                const char *begin = m_csvp->m_chunk;
+                const char *end = m_csvp->m_chunk + m_csvp->m_chunk_size;
+                while (begin != end && (*begin & 0xc0) == 0x80) {
+                    ++begin;
+                }
+                end -= SlightUtf8Validator::getIncompleteSize(begin, end - begin);
+                if (!m_csvp->m_utf8_validation || m_csvp->m_validator.validate(begin, end - begin)) {
+                    m_csvp->m_trusted_begin = begin;
+                    m_csvp->m_trusted_end = end;
+                }
+            }
+        }
+        size_t row_id = m_csvp->m_row_id;
+        m_csvp->m_chunk_offset += parseChunk(m_csvp->m_chunk + m_csvp->m_chunk_offset, 
+            m_csvp->m_chunk_size - m_csvp->m_chunk_offset);
+        // invalid UTF-8 sequences are reported once the chunk parser returns
+        if (m_csvp->m_utf8_failed && m_csvp->m_utf8_policy == UTF8_POLICY_THROW) {
+            throw u8char_format_error();
+        }
+        if (m_csvp->m_row_id != row_id) {
+            bool row_kept = !m_csvp->m_row_skipped;
+            m_csvp->m_row_skipped = false;
+            if (m_csvp->m_row_policy == ROW_POLICY_QUARANTINE) {
+                setRowText(row_id, m_csvp->m_chunk_base + m_csvp->m_chunk_offset);
+            }
+            // a row stopping the parsing without being kept is left for a later load
+            if (row_kept || !m_csvp->m_parse_done) {
+                m_csvp->m_row_end_offset = m_csvp->m_chunk_base + m_csvp->m_chunk_offset;
+                m_csvp->m_row_end_escaped = m_csvp->m_is_escaped;
+            }
+            // skipped rows are not submitted, continue with the next one
+            if (row_kept) {
+                return true;
+            }
+        }
     }
 
-    // get file size in order to support resource allocation (row count not known in advance)
-    fseek(in_file, 0L, SEEK_END);
-    m_csvp->m_file_size = ftell(in_file);
-    fseek(in_file, 0L, SEEK_SET);
-    
-    // set up variables to be used in parsing cycle
-    char in_char;
-    U8char in_u8_char;
-    U8char u8_cr = U8char("\r");
-    U8char u8_nl = U8char("\n");
-    string in_line = "";
-    bool is_escaped = false;
-    size_t row_id = 0;
-    U8char u8_bom = U8char("\xef\xbb\xbf");
-    bool bom_found = false;
-
-    // parse the file character by character
-    while (in_char = fgetc(in_file), in_char != EOF) {
-        in_u8_char.addByte(in_char);
-        if (in_u8_char) {
+    // end of input reached
+    m_csvp->m_input = 0;
+
+    // submit remaining characters for processing with row id (needed because there might be no new line character at the 
+    // end of the last row to trigger processing)
+    if (m_csvp->m_row_size) {
+        size_t row_id = m_csvp->m_row_id;
+        endRow();
+        if (m_csvp->m_row_policy == ROW_POLICY_QUARANTINE) {
+            setRowText(row_id, m_csvp->m_chunk_base + m_csvp->m_chunk_offset);
+        }
+        m_csvp->m_tail_row = !m_csvp->m_row_skipped;
+        m_csvp->m_row_skipped = false;
+        return m_csvp->m_tail_row;
+    }
+
+    return false;
+}
+
+size_t utils::SlightCSV::parseChunk(const char *t_data, const size_t t_size) {
+
+    U8char &in_u8_char = m_csvp->m_in_u8_char;
+    bool &is_escaped = m_csvp->m_is_escaped;
+
+    // parse the chunk character by character
+    for (const char *in_char = t_data; in_char != t_data + t_size; ++in_char) {
+        // bytes are handled without assembling UTF-8 characters, except while a multibyte character is incomplete or
+        // the start of a row is checked against the end of the byte range
+        if (!in_u8_char.size() && (m_csvp->m_row_started || !m_csvp->m_range_end)) {
+            // a specialized parser takes the bytes it can handle (up to the end of the row at most)
+            if (m_csvp->m_dialect_parser) {
+                size_t row_id = m_csvp->m_row_id;
+                in_char += (this->*m_csvp->m_dialect_parser)(in_char, t_data + t_size - in_char);
+                if (m_csvp->m_row_id != row_id) {
+                    return in_char - t_data;
+                }
+                if (in_char == t_data + t_size) {
+                    break;
+                }
+                // an empty line was dropped (e.g. after the BOM), the next row begins at the current byte
+                if (!m_csvp->m_row_started && m_csvp->m_range_end) {
+                    --in_char;
+                    continue;
+                }
+            }
+            // copy the run of plain bytes up to the next byte to look at at once
+            if (m_csvp->m_scan_enabled) {
+                if (m_csvp->m_fused_enabled) {
+                    // the run is added to the current cell (it contains no separators outside escaped regions), the 
+                    // escape characters in it toggle the escaped state of the cell as well
+                    bool was_escaped = is_escaped;
+                    size_t run = findRun(in_char, t_data + t_size - in_char, is_escaped, 
+                        m_csvp->m_header_detect_enabled ? &m_csvp->m_digit_count : 0);
+                    if (run) {
+                        SlightDfa::State &state = m_csvp->m_cell_state;
+                        bool is_quoted = state == SlightDfa::STATE_QUOTED;
+                        if (state == SlightDfa::STATE_EMPTY || state == SlightDfa::STATE_AFTER_SEPARATOR) {
+                            beginCell();
+                        }
+                        m_csvp->m_cells[m_csvp->m_cell_index].append(in_char, run);
+                        state = is_quoted ^ was_escaped ^ is_escaped ? SlightDfa::STATE_QUOTED : 
+                            SlightDfa::STATE_FIELD;
+                        m_csvp->m_row_size += run;
+                    }
+                    in_char += run;
+                } else {
+                    size_t run = findRun(in_char, t_data + t_size - in_char, is_escaped, 0);
+                    m_csvp->m_in_line.append(in_char, run);
+                    m_csvp->m_row_size += run;
+                    in_char += run;
+                }
+                if (in_char == t_data + t_size) {
+                    break;
+                }
+            }
+            // take the action of the row machine for the byte
+            if (m_csvp->m_dfa_enabled) {
+                const SlightDfa &dfa = m_csvp->m_dfa;
+                SlightDfa::State state = is_escaped ? SlightDfa::STATE_QUOTED : SlightDfa::STATE_FIELD;
+                bool is_handled = true;
+                switch (dfa.getAction(state, *in_char)) {
+                    case SlightDfa::ACTION_COPY:
+                        addToRow(in_char, 1);
+                        break;
+                    case SlightDfa::ACTION_REPLACE: {
+                        const string &replacement = dfa.getReplacement(*in_char);
+                        addToRow(replacement.data(), replacement.size());
+                        break;
+                    }
+                    case SlightDfa::ACTION_ROW_END:
+                        // empty lines (e.g. \r\n) are not rows
+                        if (m_csvp->m_row_size) {
+                            is_escaped = dfa.getNext(state, *in_char) == SlightDfa::STATE_QUOTED;
+                            endRow();
+                            return in_char - t_data + 1;
+                        }
+                        // a line of stripped characters only is not a row either
+                        m_csvp->m_row_started = false;
+                        break;
+                    case SlightDfa::ACTION_MULTIBYTE: {
+                        // the first row is checked for the BOM and characters continuing in the next chunk are
+                        // assembled character by character
+                        size_t length = 0;
+                        U8char::Status status = U8char::STATUS_INCOMPLETE;
+                        if (m_csvp->m_row_id || m_csvp->m_bom_found) {
+                            status = SlightDfa::checkChar(in_char, t_data + t_size - in_char, length);
+                        }
+                        if (status == U8char::STATUS_INVALID_CONTINUATION) {
+                            // the byte breaking the sequence is looked at next (the escaped state is unchanged)
+                            if (!handleUtf8Error(UTF8_ERROR_INVALID_CONTINUATION, 
+                                m_csvp->m_chunk_base + m_csvp->m_chunk_offset + (in_char - t_data))) {
+                                return in_char - t_data;
+                            }
+                            in_char += length - 1;
+                            continue;
+                        }
+                        if (status == U8char::STATUS_VALID) {
+                            // multibyte characters may be stripped off or replaced (never special characters here)
+                            const string *replacement = 0;
+                            SlightDfa::Rule rule = dfa.hasMultibyteRules() ? 
+                                dfa.getRule(in_char, length, replacement) : SlightDfa::RULE_NONE;
+                            if (rule == SlightDfa::RULE_REPLACE) {
+                                addToRow(replacement->data(), replacement->size());
+                            } else if (rule == SlightDfa::RULE_NONE) {
+                                addToRow(in_char, length);
+                            }
+                            in_char += length - 1;
+                        } else {
+                            is_handled = false;
+                        }
+                        break;
+                    }
+                    case SlightDfa::ACTION_ERROR:
+                        if (!handleUtf8Error(UTF8_ERROR_INVALID_LEAD, 
+                            m_csvp->m_chunk_base + m_csvp->m_chunk_offset + (in_char - t_data))) {
+                            return in_char - t_data;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                if (is_handled) {
+                    is_escaped = dfa.getNext(state, *in_char) == SlightDfa::STATE_QUOTED;
+                    continue;
+                }
+            }
+        }
+        // characters are assembled without exceptions, invalid sequences are handled by the policy
+        U8char::Status status = in_u8_char.tryAddByte(*in_char);
+        if (status == U8char::STATUS_INVALID_CONTINUATION || status == U8char::STATUS_TOO_LONG) {
+            // the bytes added before form an invalid sequence, the byte may begin the next character
+            size_t offset = m_csvp->m_chunk_base + m_csvp->m_chunk_offset + (in_char - t_data) - 
+                in_u8_char.getCount();
+            in_u8_char.clear();
+            if (!handleUtf8Error(UTF8_ERROR_INVALID_CONTINUATION, offset)) {
+                return in_char - t_data;
+            }
+            status = in_u8_char.tryAddByte(*in_char);
+        }
+        if (status == U8char::STATUS_INVALID_LEAD) {
+            if (!handleUtf8Error(UTF8_ERROR_INVALID_LEAD, 
+                m_csvp->m_chunk_base + m_csvp->m_chunk_offset + (in_char - t_data))) {
+                return in_char - t_data;
+            }
+            continue;
+        }
+        if (status == U8char::STATUS_VALID) {
+            bool is_new_line = in_u8_char.isEqual(U8_CR) || in_u8_char.isEqual(U8_NL);
+            // in byte range loading, stop at the first row beginning at or after the end of the range
+            if (m_csvp->m_range_end && !m_csvp->m_row_started && !is_new_line) {
+                m_csvp->m_row_started = true;
+                size_t row_start = m_csvp->m_chunk_base + m_csvp->m_chunk_offset + (in_char - t_data) + 1 - 
+                    in_u8_char.size();
+                if (row_start >= m_csvp->m_range_end) {
+                    m_csvp->m_parse_done = true;
+                    in_u8_char.clear();
+                    return in_char - t_data;
+                }
+            }
             // if processing first row and BOM not found yet
-            if (!row_id && !bom_found) {
+            if (!m_csvp->m_row_id && !m_csvp->m_bom_found) {
                 // if found BOM
-                if (in_u8_char == u8_bom) {
+                if (in_u8_char.isEqual(U8_BOM)) {
                     // set found variable, strip it off and continue
-                    bom_found = true;
+                    m_csvp->m_bom_found = true;
                     in_u8_char.clear();
                     continue;
                 }
             }
-            // if there is at least one character to be stripped
-            if (m_csvp->m_strip_chars.size()) {
-                    // if the incoming character is present in the strip set
-                    if (m_csvp->m_strip_chars.count(in_u8_char)) {
-                        // don't put it in the buffer
-                        // clear UTF8 character
-                        in_u8_char.clear();
-                        continue;
-                    }
-                }
+            // look up the strip and replace rules of the character
+            const char *char_buff = in_u8_char.getData();
+            const string *replacement = 0;
+            SlightDfa::Rule rule = m_csvp->m_dfa.getRule(char_buff, in_u8_char.size(), replacement);
+            // if the incoming character is to be stripped off
+            if (rule == SlightDfa::RULE_STRIP) {
+                // don't put it in the buffer
+                // clear UTF8 character
+                in_u8_char.clear();
+                continue;
+            }
             // if the escape character is set
             if (m_csvp->m_escape) {
                 // if the incoming character matches the escape character
-                if (in_u8_char == m_csvp->m_escape) {
+                if (in_u8_char.isEqual(m_csvp->m_escape)) {
                     // set escaped state by a XOR
                     // this is an efficient way of keeping track of escape state without using expensive "maps"
                     is_escaped ^= true;
                 }
             }
             // if incoming character is not newline, or if the character is escaped
-            if ((in_u8_char != u8_cr && in_u8_char != u8_nl) || is_escaped) {
-                // if there are any characters to be replaced
-                if (m_csvp->m_rep_chars.size()) {
-                    // check if the incoming character needs to be replaced
-                    map<U8char, U8char>::const_iterator it = m_csvp->m_rep_chars.find(in_u8_char);
-                    // if incoming character needs to be replaced
-                    if (it != m_csvp->m_rep_chars.end()) {
-                        // replace "replacee" with "replacer"
-                        in_u8_char = it->second;
-                    }
+            if (!is_new_line || is_escaped) {
+                // add character (or its replacement) to the row
+                if (rule == SlightDfa::RULE_REPLACE) {
+                    addToRow(replacement->data(), replacement->size());
+                } else {
+                    addToRow(char_buff, in_u8_char.size());
                 }
-                // add character to line buffer
-                char char_buff[5] = {0};
-                in_u8_char.getBytes(char_buff, 4);
-                in_line += char_buff;
             // if incoming character is newline, and it is not escaped
             } else {
-                // if incoming line is not empty (might be if two new lines follow each other, e.g. \r\n)
-                if (in_line.size()) {
-                    // submit line for processing with row id
-                    processRow(in_line, row_id);
-                    // clear line buffer
-                    in_line.clear();
-                    // increment row id
-                    ++row_id;
+                // if incoming row is not empty (might be if two new lines follow each other, e.g. \r\n)
+                if (m_csvp->m_row_size) {
+                    // submit row for processing
+                    endRow();
+                    // return after each row (number of bytes consumed)
+                    in_u8_char.clear();
+                    return in_char - t_data + 1;
                 }
+                m_csvp->m_row_started = false;
             }
 
             in_u8_char.clear();
@@ -252,18 +2049,345 @@ size_t utils::SlightCSV::loadData(void) {
         }
 
     }
-    
-    // submit remaining characters for processing with row id (needed because there might be no new line character at the 
-    // end of the last row to trigger processing)
-    processRow(in_line, row_id);
 
-    // close file
-    fclose(in_file);
+    return t_size;
+}
 
-    // set return value (number if rows processed)
-    retval = m_csvp->m_data_matrix.getRowCount();
+template <char t_separator, char t_escape>
+size_t utils::SlightCSV::parseDialect(const char *t_data, const size_t t_size) {
 
-    return retval;
+    // the same transitions as the row and cell machines in fused mode (the escaped state of the cell is the escaped 
+    // state of the row), with the separator and escape characters known at compile time
+    bool is_escaped = m_csvp->m_is_escaped;
+    SlightDfa::State state = m_csvp->m_cell_state;
+    size_t row_size = m_csvp->m_row_size;
+    size_t digit_count = m_csvp->m_digit_count;
+    const bool count_digits = m_csvp->m_header_detect_enabled;
+    vector<string> &cells = m_csvp->m_cells;
+    const char *in_char = t_data;
+    const char *end = t_data + t_size;
+    while (in_char != end) {
+        // plain bytes up to the next structural byte, NUL byte or byte of a multibyte character, compared one by one
+        // for short runs (short cells), the rest of a long run is left to the scanner
+        const char *run = in_char;
+        const char *limit = end - run > DIALECT_SCAN_THRESHOLD ? run + DIALECT_SCAN_THRESHOLD : end;
+        if (is_escaped) {
+            while (run != limit && *run != t_escape && (unsigned char)(*run - 1) < 0x7f) {
+                digit_count += count_digits && (unsigned char)(*run - '0') < 10;
+                ++run;
+            }
+        } else {
+            while (run != limit && *run != t_separator && (!t_escape || *run != t_escape) && *run != '\r' && 
+                *run != '\n' && (unsigned char)(*run - 1) < 0x7f) {
+                digit_count += count_digits && (unsigned char)(*run - '0') < 10;
+                ++run;
+            }
+        }
+        if (run == limit && run != end) {
+            // escape characters within the run change the escaped state of the cell as well
+            run += findRun(run, end - run, is_escaped, count_digits ? &digit_count : 0);
+        }
+        if (run != in_char) {
+            if (state == SlightDfa::STATE_EMPTY || state == SlightDfa::STATE_AFTER_SEPARATOR) {
+                beginCell();
+            }
+            cells[m_csvp->m_cell_index].append(in_char, run - in_char);
+            state = is_escaped ? SlightDfa::STATE_QUOTED : SlightDfa::STATE_FIELD;
+            row_size += run - in_char;
+            in_char = run;
+            if (in_char == end) {
+                break;
+            }
+        }
+        if (t_escape && *in_char == t_escape) {
+            // escape characters are kept in the cell
+            is_escaped ^= true;
+            if (state == SlightDfa::STATE_EMPTY || state == SlightDfa::STATE_AFTER_SEPARATOR) {
+                beginCell();
+            }
+            cells[m_csvp->m_cell_index] += t_escape;
+            state = is_escaped ? SlightDfa::STATE_QUOTED : SlightDfa::STATE_FIELD;
+            ++row_size;
+        } else if (!is_escaped && *in_char == t_separator) {
+            // empty cells are stored as null cells (or as zero)
+            if (state == SlightDfa::STATE_EMPTY || state == SlightDfa::STATE_AFTER_SEPARATOR) {
+                beginCell();
+                if (m_csvp->m_empty_cell_mode == EMPTY_CELL_ZERO) {
+                    cells[m_csvp->m_cell_index] = "0";
+                }
+            }
+            ++m_csvp->m_cell_index;
+            state = SlightDfa::STATE_AFTER_SEPARATOR;
+            ++row_size;
+        } else if (!is_escaped && (*in_char == '\r' || *in_char == '\n')) {
+            // empty lines (e.g. \r\n) are not rows
+            if (row_size) {
+                m_csvp->m_is_escaped = false;
+                m_csvp->m_cell_state = state;
+                m_csvp->m_row_size = row_size;
+                m_csvp->m_digit_count = digit_count;
+                endRow();
+                return in_char - t_data + 1;
+            }
+            m_csvp->m_row_started = false;
+            // in byte range loading, the beginning of the next row is checked against the end of the range first
+            if (m_csvp->m_range_end) {
+                ++in_char;
+                break;
+            }
+        } else {
+            // NUL bytes and multibyte characters are left to the generic parser
+            break;
+        }
+        ++in_char;
+    }
+
+    m_csvp->m_is_escaped = is_escaped;
+    m_csvp->m_cell_state = state;
+    m_csvp->m_row_size = row_size;
+    m_csvp->m_digit_count = digit_count;
+    return in_char - t_data;
+}
+
+size_t utils::SlightCSV::findRun(const char *t_data, const size_t t_size, bool &t_is_escaped, 
+    size_t *t_digit_count) const {
+    // in the validated range of the chunk, multibyte characters are part of the run (the first row is checked for
+    // the BOM character by character)
+    const SlightScanner *scanner = &m_csvp->m_scanner;
+    size_t size = t_size;
+    if (t_data >= m_csvp->m_trusted_begin && t_data < m_csvp->m_trusted_end && 
+        (m_csvp->m_row_id || m_csvp->m_bom_found)) {
+        scanner = &m_csvp->m_text_scanner;
+        size = std::min(t_size, (size_t)(m_csvp->m_trusted_end - t_data));
+    }
+    return t_digit_count ? scanner->find(t_data, size, t_is_escaped, *t_digit_count) : 
+        scanner->find(t_data, size, t_is_escaped);
+}
+
+void utils::SlightCSV::addToRow(const char *t_bytes, const size_t t_size) {
+    m_csvp->m_row_size += t_size;
+    if (!m_csvp->m_fused_enabled) {
+        m_csvp->m_in_line.append(t_bytes, t_size);
+        return;
+    }
+
+    // split the bytes (complete characters) into cells with the cell machine
+    const SlightDfa &dfa = m_csvp->m_cell_dfa;
+    SlightDfa::State &state = m_csvp->m_cell_state;
+    vector<string> &cells = m_csvp->m_cells;
+    const bool count_digits = m_csvp->m_header_detect_enabled;
+    for (size_t i = 0; i < t_size; ++i) {
+        if (count_digits && t_bytes[i] >= '0' && t_bytes[i] <= '9') {
+            ++m_csvp->m_digit_count;
+        }
+        SlightDfa::State next = dfa.getNext(state, t_bytes[i]);
+        switch (dfa.getAction(state, t_bytes[i])) {
+            case SlightDfa::ACTION_COPY:
+                if (state == SlightDfa::STATE_EMPTY || state == SlightDfa::STATE_AFTER_SEPARATOR) {
+                    beginCell();
+                }
+                cells[m_csvp->m_cell_index] += t_bytes[i];
+                break;
+            case SlightDfa::ACTION_CELL_END:
+                ++m_csvp->m_cell_index;
+                break;
+            case SlightDfa::ACTION_EMPTY_CELL:
+                // empty cells are stored as null cells (or as zero)
+                beginCell();
+                if (m_csvp->m_empty_cell_mode == EMPTY_CELL_ZERO) {
+                    cells[m_csvp->m_cell_index] = "0";
+                }
+                ++m_csvp->m_cell_index;
+                break;
+            case SlightDfa::ACTION_MULTIBYTE: {
+                // the bytes added are complete characters checked by the parser already
+                size_t length;
+                SlightDfa::checkChar(t_bytes + i, t_size - i, length);
+                if (state == SlightDfa::STATE_EMPTY || state == SlightDfa::STATE_AFTER_SEPARATOR) {
+                    beginCell();
+                }
+                cells[m_csvp->m_cell_index].append(t_bytes + i, length);
+                i += length - 1;
+                break;
+            }
+            default:
+                break;
+        }
+        state = next;
+    }
+}
+
+bool utils::SlightCSV::handleUtf8Error(const Utf8ErrorCode t_code, const size_t t_offset) {
+    // the sequence is recorded, errors are not thrown while bytes are parsed
+    if (m_csvp->m_utf8_errors.size() < UTF8_ERROR_RECORD_LIMIT) {
+        Utf8Error error;
+        error.m_offset = t_offset;
+        error.m_code = t_code;
+        m_csvp->m_utf8_errors.push_back(error);
+    }
+    ++m_csvp->m_utf8_error_count;
+
+    switch (m_csvp->m_utf8_policy) {
+        case UTF8_POLICY_REPLACE:
+            // in byte range loading, the replacement character may begin the first row after the range
+            if (m_csvp->m_range_end && !m_csvp->m_row_started) {
+                m_csvp->m_row_started = true;
+                if (t_offset >= m_csvp->m_range_end) {
+                    m_csvp->m_parse_done = true;
+                    return false;
+                }
+            }
+            addToRow(UTF8_REPLACEMENT, sizeof(UTF8_REPLACEMENT) - 1);
+            return true;
+        case UTF8_POLICY_SKIP:
+            return true;
+        default:
+            // parsing stops, the row of the sequence is dropped
+            m_csvp->m_utf8_failed = true;
+            m_csvp->m_parse_done = true;
+            m_csvp->m_in_line.clear();
+            m_csvp->m_row_size = 0;
+            m_csvp->m_cell_state = SlightDfa::STATE_EMPTY;
+            m_csvp->m_cell_index = 0;
+            m_csvp->m_digit_count = 0;
+            return false;
+    }
+}
+
+void utils::SlightCSV::appendUtf8Errors(const SlightCSV &t_source) {
+    const SlightCSVPrivate &source = *t_source.m_csvp;
+    size_t record_count = std::min(source.m_utf8_errors.size(), 
+        UTF8_ERROR_RECORD_LIMIT - m_csvp->m_utf8_errors.size());
+    m_csvp->m_utf8_errors.insert(m_csvp->m_utf8_errors.end(), source.m_utf8_errors.begin(), 
+        source.m_utf8_errors.begin() + record_count);
+    m_csvp->m_utf8_error_count += source.m_utf8_error_count;
+    m_csvp->m_utf8_failed = m_csvp->m_utf8_failed || source.m_utf8_failed;
+}
+
+void utils::SlightCSV::clearUtf8Errors(void) {
+    m_csvp->m_utf8_errors.clear();
+    m_csvp->m_utf8_error_count = 0;
+    m_csvp->m_utf8_failed = false;
+}
+
+void utils::SlightCSV::keepRowText(void) {
+    // the part of the current chunk after the end of the last row
+    size_t chunk_end = m_csvp->m_chunk_base + m_csvp->m_chunk_size;
+    size_t begin = std::max(m_csvp->m_row_text_offset, m_csvp->m_chunk_base);
+    if (begin < chunk_end) {
+        m_csvp->m_row_text.append(m_csvp->m_chunk + (begin - m_csvp->m_chunk_base), chunk_end - begin);
+    }
+}
+
+void utils::SlightCSV::setRowText(const size_t t_row_id, const size_t t_end) {
+    // the text of a malformed row is taken from the input between the end of the row before and its own end (the
+    // empty lines and new line characters around the row are left out)
+    if (m_csvp->m_row_rejected) {
+        m_csvp->m_row_rejected = false;
+        vector<RowError> &errors = m_csvp->m_row_errors;
+        if (errors.size() && errors.back().m_row == t_row_id) {
+            size_t begin = std::max(m_csvp->m_row_text_offset, m_csvp->m_chunk_base);
+            string &text = errors.back().m_text;
+            text.swap(m_csvp->m_row_text);
+            if (begin < t_end) {
+                text.append(m_csvp->m_chunk + (begin - m_csvp->m_chunk_base), t_end - begin);
+            }
+            size_t first = text.find_first_not_of("\r\n");
+            if (first == string::npos) {
+                first = text.size();
+            }
+            // a BOM at the beginning of the file is not part of the row
+            if (!m_csvp->m_row_text_offset && !first && m_csvp->m_bom_found && !text.compare(0, 3, "\xef\xbb\xbf")) {
+                first = text.find_first_not_of("\r\n", 3);
+                if (first == string::npos) {
+                    first = text.size();
+                }
+            }
+            errors.back().m_offset = m_csvp->m_row_text_offset + first;
+            size_t last = text.find_last_not_of("\r\n");
+            text = last == string::npos || last < first ? string() : text.substr(first, last + 1 - first);
+        }
+    }
+    m_csvp->m_row_text.clear();
+    m_csvp->m_row_text_offset = t_end;
+}
+
+void utils::SlightCSV::clearRowErrors(void) {
+    m_csvp->m_row_errors.clear();
+    m_csvp->m_row_error_count = 0;
+    m_csvp->m_row_rejected = false;
+}
+
+void utils::SlightCSV::appendRowErrors(const SlightCSV &t_source, const size_t t_row_id) {
+    // the rows of the source are counted from the given row on
+    const SlightCSVPrivate &source = *t_source.m_csvp;
+    size_t record_count = std::min(source.m_row_errors.size(), 
+        ROW_ERROR_RECORD_LIMIT - m_csvp->m_row_errors.size());
+    for (size_t i = 0; i < record_count; ++i) {
+        m_csvp->m_row_errors.push_back(source.m_row_errors[i]);
+        m_csvp->m_row_errors.back().m_row += t_row_id;
+    }
+    m_csvp->m_row_error_count += source.m_row_error_count;
+}
+
+void utils::SlightCSV::beginCell(void) {
+    // the cell strings of the previous rows are reused (their memory is kept)
+    vector<string> &cells = m_csvp->m_cells;
+    if (m_csvp->m_cell_index == cells.size()) {
+        cells.push_back(string());
+    } else {
+        cells[m_csvp->m_cell_index].clear();
+    }
+}
+
+void utils::SlightCSV::endRow(void) {
+    if (m_csvp->m_fused_enabled) {
+        // the last cell, or an empty cell if the row ends with a separator
+        SlightDfa::State state = m_csvp->m_cell_state;
+        if (state == SlightDfa::STATE_FIELD || state == SlightDfa::STATE_QUOTED) {
+            ++m_csvp->m_cell_index;
+        } else if (state == SlightDfa::STATE_AFTER_SEPARATOR) {
+            beginCell();
+            if (m_csvp->m_empty_cell_mode == EMPTY_CELL_ZERO) {
+                m_csvp->m_cells[m_csvp->m_cell_index] = "0";
+            }
+            ++m_csvp->m_cell_index;
+        }
+        m_csvp->m_cells.resize(m_csvp->m_cell_index);
+        size_t row_size = m_csvp->m_row_size;
+        bool is_header = getIsHeaderRow(m_csvp->m_row_id, SlightRow::getIsHeader(m_csvp->m_digit_count, row_size));
+        m_csvp->m_cell_state = SlightDfa::STATE_EMPTY;
+        m_csvp->m_cell_index = 0;
+        m_csvp->m_row_size = 0;
+        m_csvp->m_digit_count = 0;
+        submitRow(row_size, is_header, m_csvp->m_row_id);
+    } else {
+        m_csvp->m_row_size = 0;
+        processRow(m_csvp->m_in_line, m_csvp->m_row_id);
+        m_csvp->m_in_line.clear();
+    }
+    ++m_csvp->m_row_id;
+    m_csvp->m_row_started = false;
+    updateHeaderDetection();
+}
+
+void utils::SlightCSV::updateHeaderDetection(void) {
+    // with a limited number of rows checked, detection ends at the first data row
+    if (m_csvp->m_header_detect_enabled && m_csvp->m_header_row_count && 
+        (!m_csvp->m_row_is_header || m_csvp->m_row_id >= m_csvp->m_header_row_count)) {
+        m_csvp->m_header_detect_enabled = false;
+    }
+}
+
+bool utils::SlightCSV::getIsHeaderRow(const size_t t_row_id, const bool t_is_detected) const {
+    switch (m_csvp->m_header_mode) {
+        case HEADER_MODE_FIXED:
+            return t_row_id < m_csvp->m_header_row_count;
+        case HEADER_MODE_NONE:
+            return false;
+        default:
+            return m_csvp->m_header_detect_enabled && t_is_detected;
+    }
 }
 
 size_t utils::SlightCSV::getColumnCount(void) const {
@@ -291,6 +2415,19 @@ size_t utils::SlightCSV::getHeaderCount(void) const {
     return m_csvp->m_data_matrix.getHeaderCount();
 }
 
+bool utils::SlightCSV::isNull(const size_t t_row_index, const size_t t_column_index) const {
+    if (!m_csvp->m_data_matrix.getRowCount() || !m_csvp->m_data_matrix.getColumnCount()) {
+        throw slightcsv_data_error();
+    }
+    if (t_row_index >= m_csvp->m_data_matrix.getRowCount()) {
+        throw slightcsv_index_error();
+    }
+    if (t_column_index >= m_csvp->m_data_matrix.getColumnCount()) {
+        throw slightcsv_index_error();
+    }
+    return m_csvp->m_data_matrix.isNull(t_row_index, t_column_index);
+}
+
 template <class T>
 void utils::SlightCSV::getCell(T &t_value, const size_t t_row_index, const size_t t_column_index) const {
     if (!m_csvp->m_data_matrix.getRowCount() || !m_csvp->m_data_matrix.getColumnCount()) {
@@ -302,7 +2439,11 @@ void utils::SlightCSV::getCell(T &t_value, const size_t t_row_index, const size_
     if (t_column_index >= m_csvp->m_data_matrix.getColumnCount()) {
         throw slightcsv_index_error();
     }
-    m_csvp->m_data_matrix.getCell(t_value, t_row_index, t_column_index);
+    try {
+        m_csvp->m_data_matrix.getCell(t_value, t_row_index, t_column_index);
+    } catch (const slightmatrix_null_error &e) {
+        throw slightcsv_null_error();
+    }
 }
 
 template void utils::SlightCSV::getCell(string &t_value, size_t t_row_index, size_t t_column_index) const;
@@ -318,7 +2459,11 @@ void utils::SlightCSV::getColumn(vector<T> &t_target_column, const size_t t_colu
     if (t_column_index >= m_csvp->m_data_matrix.getColumnCount()) {
         throw slightcsv_index_error();
     }
-    m_csvp->m_data_matrix.getColumn(t_target_column, t_column_index);
+    try {
+        m_csvp->m_data_matrix.getColumn(t_target_column, t_column_index);
+    } catch (const slightmatrix_null_error &e) {
+        throw slightcsv_null_error();
+    }
 }
 
 template void utils::SlightCSV::getColumn(vector<int> &t_target_column, const size_t t_column_index) const;
@@ -339,7 +2484,11 @@ void utils::SlightCSV::getColumn(vector<T> &t_target_column, const size_t t_colu
     if (t_start_cell_index > m_csvp->m_data_matrix.getRowCount() - 1) {
         throw slightcsv_index_error();
     }
-    m_csvp->m_data_matrix.getColumn(t_target_column, t_column_index, t_start_cell_index);
+    try {
+        m_csvp->m_data_matrix.getColumn(t_target_column, t_column_index, t_start_cell_index);
+    } catch (const slightmatrix_null_error &e) {
+        throw slightcsv_null_error();
+    }
 }
 
 template void utils::SlightCSV::getColumn(vector<int> &t_target_column, const size_t t_column_index, 
@@ -367,7 +2516,11 @@ void utils::SlightCSV::getColumn(vector<T> &t_target_column, const size_t t_colu
     if (t_start_cell_index + t_cell_count > m_csvp->m_data_matrix.getRowCount()) {
         throw slightcsv_index_error();
     }
-    m_csvp->m_data_matrix.getColumn(t_target_column, t_column_index, t_start_cell_index, t_cell_count);
+    try {
+        m_csvp->m_data_matrix.getColumn(t_target_column, t_column_index, t_start_cell_index, t_cell_count);
+    } catch (const slightmatrix_null_error &e) {
+        throw slightcsv_null_error();
+    }
 }
 
 template void utils::SlightCSV::getColumn(vector<int> &t_target_column, const size_t t_column_index, 
@@ -429,6 +2582,8 @@ void utils::SlightCSV::unloadData(void) {
     m_csvp->m_csv_format_detect_done = false;
     m_csvp->m_row.clear();
     m_csvp->m_file_size = 0;
+    m_csvp->m_in_line.clear();
+    m_csvp->m_reload_valid = false;
 }
 
 void utils::SlightCSV::reset(void) {
@@ -440,6 +2595,34 @@ void utils::SlightCSV::reset(void) {
     m_csvp->m_csv_format_detect_done = false;
     m_csvp->m_row.reset();
     m_csvp->m_file_size = 0;
+    m_csvp->m_read_mode = READ_MODE_STDIO;
+    m_csvp->m_buffer_size = DEFAULT_BUFFER_SIZE;
+    m_csvp->m_buffer_count = DEFAULT_BUFFER_COUNT;
+    m_csvp->m_stall_time = 0;
+    m_csvp->m_row_handler = 0;
+    m_csvp->m_cursor_mode = false;
+    m_csvp->m_slot_matrix = 0;
+    m_csvp->m_input = 0;
+    m_csvp->m_in_line.clear();
+    m_csvp->m_compressed = false;
+    m_csvp->m_reload_valid = false;
+    m_csvp->m_row_skip = 0;
+    m_csvp->m_row_limit = 0;
+    m_csvp->m_empty_cell_mode = EMPTY_CELL_NULL;
+    m_csvp->m_data_matrix.setNullPolicy(SlightMatrix::NULL_POLICY_VALUE);
+    m_csvp->m_data_matrix.setNullValue("");
+    m_csvp->m_header_mode = HEADER_MODE_DETECT;
+    m_csvp->m_header_row_count = 0;
+    m_csvp->m_header_detect_enabled = true;
+    m_csvp->m_utf8_policy = UTF8_POLICY_THROW;
+    m_csvp->m_utf8_validation = true;
+    clearUtf8Errors();
+    m_csvp->m_row_policy = ROW_POLICY_THROW;
+    clearRowErrors();
+    m_csvp->m_row_text.clear();
+    m_csvp->m_row_text_offset = 0;
+    m_csvp->m_thread_count = 0;
+    m_csvp->m_min_chunk_size = DEFAULT_MIN_CHUNK_SIZE;
 }
 
 void utils::SlightCSV::processRow(string &t_input, size_t const t_row_id) {
@@ -457,19 +2640,64 @@ void utils::SlightCSV::processRow(string &t_input, size_t const t_row_id) {
     // process row
     m_csvp->m_row.process();
 
+    // get parsed cells from row (the buffer is reused between rows)
+    m_csvp->m_row.getCells(m_csvp->m_cells);
+
+    submitRow(t_input.size(), getIsHeaderRow(t_row_id, m_csvp->m_row.getIsHeader()), t_row_id);
+}
+
+void utils::SlightCSV::submitRow(const size_t t_row_size, const bool t_is_header, const size_t t_row_id) {
+
+    vector<string> &cells = m_csvp->m_cells;
+    m_csvp->m_row_is_header = t_is_header;
+
     // determine column count from the first row processed
-    // reserve memory for the estimated number of cells (based on file size, row size and cell count in row)
+    // reserve memory for the estimated number of cells (based on file size, row size and cell count in row), rows are
+    // not stored in streaming mode
+    // if the input size is not known (pipes), the estimate is based on the first chunk read and the data matrix grows 
+    // geometrically from there
     if (!m_csvp->m_csv_format_detect_done) {
-        m_csvp->m_data_matrix.setCapacity(m_csvp->m_file_size / t_input.size() * m_csvp->m_row.getCellCount());
-        m_csvp->m_data_matrix.setColumnCount(m_csvp->m_row.getCellCount());
+        size_t input_size = m_csvp->m_file_size ? m_csvp->m_file_size : m_csvp->m_chunk_size;
+        size_t cell_count = input_size / t_row_size * cells.size();
+        // with a row limit, no more than the limited number of rows (and a header) are stored
+        if (m_csvp->m_row_limit && m_csvp->m_row_limits_active) {
+            cell_count = std::min(cell_count, (m_csvp->m_row_limit + 1) * cells.size());
+        }
+        if (!m_csvp->m_row_handler && !m_csvp->m_cursor_mode && cell_count) {
+            m_csvp->m_data_matrix.setCapacity(cell_count);
+        }
+        m_csvp->m_data_matrix.setColumnCount(cells.size());
         m_csvp->m_csv_format_detect_done = true;
     }
 
+    // when looking for the header rows only, the first other row ends parsing
+    if (m_csvp->m_headers_only && !t_is_header) {
+        m_csvp->m_parse_done = true;
+        m_csvp->m_row_skipped = true;
+        return;
+    }
+
+    // in quarantine mode, malformed rows are recorded and left out (the raw text of the row is added once its end is
+    // known, see setRowText())
+    if (cells.size() != m_csvp->m_data_matrix.getColumnCount() && m_csvp->m_row_policy == ROW_POLICY_QUARANTINE) {
+        if (m_csvp->m_row_errors.size() < ROW_ERROR_RECORD_LIMIT) {
+            RowError error;
+            error.m_row = t_row_id;
+            error.m_offset = 0;
+            error.m_cell_count = cells.size();
+            m_csvp->m_row_errors.push_back(error);
+        }
+        ++m_csvp->m_row_error_count;
+        m_csvp->m_row_rejected = true;
+        m_csvp->m_row_skipped = true;
+        return;
+    }
+
     // check if row is header
     // multiple headers are allowed, but only at the beginning of the file
     // if a non-header comes after a header, more headers are not allowed (exception is thrown)
     // TODO: make approximate row number available in the exception
-    if (m_csvp->m_row.getIsHeader()) {
+    if (t_is_header) {
         size_t header_count = m_csvp->m_data_matrix.getHeaderCount();
         if (t_row_id == header_count) {
             m_csvp->m_data_matrix.setHeaderCount(++header_count);
@@ -480,13 +2708,41 @@ void utils::SlightCSV::processRow(string &t_input, size_t const t_row_id) {
 
     // if cell count is not consistent, an exception is thrown
     // TODO: make approximate row number available in the exception
-    if (m_csvp->m_row.getCellCount() != m_csvp->m_data_matrix.getColumnCount()) {
+    if (cells.size() != m_csvp->m_data_matrix.getColumnCount()) {
         throw slightcsv_format_cellcnt_error();
     }
     
-    // get parsed cells from row
-    vector<string> cells;
-    m_csvp->m_row.getCells(cells);
+    // skip and limit data rows (header rows are always loaded)
+    if (m_csvp->m_row_limits_active && !t_is_header) {
+        ++m_csvp->m_data_row_count;
+        if (m_csvp->m_data_row_count <= m_csvp->m_row_skip) {
+            m_csvp->m_row_skipped = true;
+            return;
+        }
+        // stop reading as soon as the limit is reached
+        if (m_csvp->m_row_limit && m_csvp->m_data_row_count == m_csvp->m_row_skip + m_csvp->m_row_limit) {
+            m_csvp->m_parse_done = true;
+        }
+    }
+
+    // in cursor mode, keep cells for the cursor to pick them up
+    if (m_csvp->m_cursor_mode) {
+        m_csvp->m_cursor_row_id = t_row_id;
+        return;
+    }
+
+    // in parallel loading, the cells are moved to the row reserved for them in the shared data matrix
+    if (m_csvp->m_slot_matrix) {
+        m_csvp->m_slot_matrix->setRow(m_csvp->m_slot_row + m_csvp->m_handled_row_count++, cells);
+        return;
+    }
+
+    // in streaming mode, pass cells to the row handler instead of storing them
+    if (m_csvp->m_row_handler) {
+        m_csvp->m_row_handler->handleRow(cells, t_row_id, t_is_header);
+        ++m_csvp->m_handled_row_count;
+        return;
+    }
     
     // add cells to data matrix
     m_csvp->m_data_matrix.addCells(cells);
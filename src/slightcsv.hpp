@@ -22,6 +22,8 @@
 #include <set>
 #include <map>
 #include <exception>
+#include <cstdio>
+#include <istream>
 
 using std::string;
 using std::vector;
@@ -35,12 +37,131 @@ namespace utils {
     /// A forward declared class to hold SlightCSV's private data members (pImpl).
     class SlightCSVPrivate;
 
+    /// A forward declared class representing the source the CSV data is read from.
+    class SlightInput;
+    class SlightStreamInput;
+
+    /// A forward declared class holding the loaded data.
+    class SlightMatrix;
+
+    /// Interface of the row handlers used in streaming mode. Implement it and pass an instance of the derived class
+    /// to SlightCSV::setRowHandler() in order to receive the parsed rows one by one during data loading, instead
+    /// of having them stored in memory.
+    class SlightRowHandler {
+
+        public:
+            /// Virtual destructor of the class.
+            virtual ~SlightRowHandler(void) {}
+
+            /// Method called by the library for each parsed row, in file order. Header detection and cell count 
+            /// verification are done before the call. The cells are only valid during the call (copy them if 
+            /// needed later).
+            /// \param t_cells cells of the row.
+            /// \param t_row_id index (starting from 0) of the row in the file, header rows included.
+            /// \param t_is_header header flag of the row.
+            virtual void handleRow(const vector<string> &t_cells, const size_t t_row_id, const bool t_is_header) = 0;
+
+    };
+
     /// The "main" class of the library. Provides methods for setting up the library, triggering data processing 
     ///  and getting the results.
     class SlightCSV {
 
         public:
 
+            /// Strategies for reading the CSV file during data loading.
+            enum ReadMode {
+                /// The file is read in large blocks through the C standard library's stream functions (default).
+                READ_MODE_STDIO,
+                /// The file is mapped into memory in sliding windows and parsed directly from the mapped pages. 
+                /// Not available on Windows (stream reading is used instead).
+                READ_MODE_MMAP,
+                /// The file is read in large blocks on a separate I/O thread into a ring of buffers, while the 
+                /// parser processes the buffers already filled (reading and parsing overlap).
+                READ_MODE_READ_AHEAD,
+                /// The file is read through io_uring with several large reads kept in flight, completed blocks are 
+                /// parsed in file order. Linux only, stream reading is used if io_uring is not available at runtime.
+                READ_MODE_IO_URING
+            };
+
+            /// Policies for recognizing the header rows at the beginning of the CSV file.
+            enum HeaderMode {
+                /// Header rows are detected by their contents: a row is a header if at most 10 percent of its bytes 
+                /// are numeric characters (default). See setHeaderRowCount() for limiting the rows checked.
+                HEADER_MODE_DETECT,
+                /// A given number of rows at the beginning of the file are header rows (see setHeaderRowCount()), 
+                /// regardless of their contents.
+                HEADER_MODE_FIXED,
+                /// There are no header rows, all rows are data rows.
+                HEADER_MODE_NONE
+            };
+
+            /// Policies for handling invalid UTF-8 sequences in the CSV file.
+            enum Utf8ErrorPolicy {
+                /// Loading stops at the first invalid sequence with an UTF-8 format error exception (default).
+                UTF8_POLICY_THROW,
+                /// Loading stops at the first invalid sequence without an exception. The rows before the row of the 
+                /// sequence are kept.
+                UTF8_POLICY_ABORT,
+                /// Invalid sequences are replaced with the replacement character (U+FFFD).
+                UTF8_POLICY_REPLACE,
+                /// Invalid sequences are left out of the cells.
+                UTF8_POLICY_SKIP
+            };
+
+            /// Kinds of invalid UTF-8 sequences.
+            enum Utf8ErrorCode {
+                /// A byte which cannot begin a character (continuation byte or invalid length indication).
+                UTF8_ERROR_INVALID_LEAD,
+                /// The beginning of a character followed by a byte which is not a continuation byte.
+                UTF8_ERROR_INVALID_CONTINUATION
+            };
+
+            /// Policies for handling malformed rows (rows with a cell count different from the first row's).
+            enum RowErrorPolicy {
+                /// Loading stops at the first malformed row with a cell count exception (default).
+                ROW_POLICY_THROW,
+                /// Malformed rows are left out of the data and recorded (see getRowErrors()), loading continues.
+                ROW_POLICY_QUARANTINE
+            };
+
+            /// Storage of empty fields (no characters between separators).
+            enum EmptyCellMode {
+                /// Empty fields are stored as null cells (empty strings, no memory allocated for them, see isNull()).
+                EMPTY_CELL_NULL,
+                /// Empty fields are stored as "0" (behavior of earlier versions).
+                EMPTY_CELL_ZERO
+            };
+
+            /// Handling of null cells by the typed data query methods (getCell(), getColumn()).
+            enum NullPolicy {
+                /// Null cells are converted from the null value (see setNullValue(), empty by default: zero for 
+                /// numeric types and an empty string).
+                NULL_POLICY_VALUE,
+                /// Querying a null cell throws an exception.
+                NULL_POLICY_THROW
+            };
+
+            /// Invalid UTF-8 sequence found during data loading.
+            struct Utf8Error {
+                /// Byte offset of the sequence in the file (in the decompressed data of compressed files).
+                size_t m_offset;
+                /// Kind of the sequence.
+                Utf8ErrorCode m_code;
+            };
+
+            /// Malformed row left out during data loading.
+            struct RowError {
+                /// Row number of the row in the file (counted from zero, header rows included).
+                size_t m_row;
+                /// Byte offset of the row in the file (in the decompressed data of compressed files).
+                size_t m_offset;
+                /// Number of cells found in the row.
+                size_t m_cell_count;
+                /// Raw text of the row, without the new line characters ending it.
+                string m_text;
+            };
+
             /// The class's default constructor. Takes care of allocating memory for the class's private data members.
             SlightCSV(void);
 
@@ -58,7 +179,8 @@ namespace utils {
             string getFileName(void) const;
 
             /// Method to set the delimiter character. It is used as a separator between "cells" in a row. Required 
-            /// before triggering data loading.
+            /// before triggering data loading. Common dialects (comma, semicolon or tab delimiter, double quote or no
+            /// escape character, no strip and replace characters) are parsed by code specialized for them.
             /// \param t_separator character to use as delimiter.
             /// \see getSeparator()
             void setSeparator(const string t_separator);
@@ -112,11 +234,348 @@ namespace utils {
             /// \see setReplaceChars()
             void getReplaceChars(map<string, string> &t_target) const;
 
-            /// Method to trigger data loading. Requires filename and delimiter to be set before calling it.
-            /// \return the number of records loaded.
+            /// Method to select the strategy used for reading the file during data loading. Memory mapping avoids
+            /// copying the file contents and per-character library calls, which pays off for large files. Optional 
+            /// method, stream reading is used by default. If used, set it before triggering data loading.
+            /// \param t_read_mode read strategy to use.
+            /// \see getReadMode()
+            void setReadMode(const ReadMode t_read_mode);
+
+            /// Method to get the previously set file read strategy.
+            /// \return read strategy used during data loading.
+            /// \see setReadMode()
+            ReadMode getReadMode(void) const;
+
+            /// Method to set the size of the buffer the file is read into in stream reading mode. Larger buffers mean
+            /// less library calls per byte, rows and UTF-8 characters spanning buffer boundaries are handled 
+            /// transparently. Optional method, 1 MiB is used by default. If used, set it before triggering data loading.
+            /// \param t_buffer_size size of the read buffer in bytes.
+            /// \see getBufferSize()
+            /// \see setReadMode()
+            void setBufferSize(const size_t t_buffer_size);
+
+            /// Method to get the previously set size of the read buffer.
+            /// \return size of the read buffer in bytes.
+            /// \see setBufferSize()
+            size_t getBufferSize(void) const;
+
+            /// Method to set the row handler receiving the parsed rows in streaming mode. While a handler is set, 
+            /// loaded rows are passed to it and are not stored (data query methods throw as no data is loaded), so
+            /// memory usage does not depend on the size of the file. Optional method, set it to null (default) to 
+            /// store rows in memory. If used, set it before triggering data loading. The handler is not owned by 
+            /// the library.
+            /// \param t_row_handler row handler object or null.
+            /// \see getRowHandler()
+            void setRowHandler(SlightRowHandler *t_row_handler);
+
+            /// Method to get the previously set row handler.
+            /// \return row handler object or null if streaming mode is not used.
+            /// \see setRowHandler()
+            SlightRowHandler* getRowHandler(void) const;
+
+            /// Method to set the number of data rows (header rows are not counted) to skip at the beginning of the 
+            /// data. Skipped rows are parsed, but not stored (or passed to the row handler). Optional method, no rows 
+            /// are skipped by default. If used, set it before triggering data loading.
+            /// \param t_row_skip number of data rows to skip.
+            /// \see getRowSkip()
+            /// \see setRowLimit()
+            void setRowSkip(const size_t t_row_skip);
+
+            /// Method to get the previously set number of data rows to skip.
+            /// \return number of data rows to skip.
+            /// \see setRowSkip()
+            size_t getRowSkip(void) const;
+
+            /// Method to set the maximum number of data rows (header rows are not counted) to load. Reading stops as 
+            /// soon as the limit is reached, the rest of the file is not read (e.g. previews, schema checks), and 
+            /// memory is reserved for the limited number of rows only. Optional method, zero (default) means no 
+            /// limit. If used, set it before triggering data loading.
+            /// \param t_row_limit maximum number of data rows to load.
+            /// \see getRowLimit()
+            /// \see setRowSkip()
+            void setRowLimit(const size_t t_row_limit);
+
+            /// Method to get the previously set maximum number of data rows to load.
+            /// \return maximum number of data rows to load (zero if not limited).
+            /// \see setRowLimit()
+            size_t getRowLimit(void) const;
+
+            /// Method to select the policy for recognizing header rows. Optional method, header rows are detected by 
+            /// their contents in every row by default. If used, set it before triggering data loading.
+            /// \param t_header_mode header policy to use.
+            /// \see getHeaderMode()
+            /// \see setHeaderRowCount()
+            void setHeaderMode(const HeaderMode t_header_mode);
+
+            /// Method to get the previously set header policy.
+            /// \return header policy used during data loading.
+            /// \see setHeaderMode()
+            HeaderMode getHeaderMode(void) const;
+
+            /// Method to set the number of header rows in fixed header mode, or the number of rows checked at the 
+            /// beginning of the file in detecting header mode. When it is limited, detection stops at the first data 
+            /// row (or after the given number of rows), the rest of the rows are data rows and they are not checked
+            /// at all. Zero (default) means that every row is checked, a header row after data rows is a format error.
+            /// Not used without header rows. If used, set it before triggering data loading.
+            /// \param t_row_count number of header rows (fixed mode) or rows checked (detecting mode).
+            /// \see getHeaderRowCount()
+            /// \see setHeaderMode()
+            void setHeaderRowCount(const size_t t_row_count);
+
+            /// Method to get the previously set number of header rows or rows checked for header detection.
+            /// \return number of header rows (fixed mode) or rows checked (detecting mode, zero if not limited).
+            /// \see setHeaderRowCount()
+            size_t getHeaderRowCount(void) const;
+
+            /// Method to select the policy for handling invalid UTF-8 sequences. Optional method, loading stops with
+            /// an exception by default. Invalid sequences are recorded with their offsets in all cases (see 
+            /// getUtf8Errors()). If used, set it before triggering data loading.
+            /// \param t_policy policy to use.
+            /// \see getUtf8ErrorPolicy()
+            void setUtf8ErrorPolicy(const Utf8ErrorPolicy t_policy);
+
+            /// Method to get the previously set policy for handling invalid UTF-8 sequences.
+            /// \return policy used during data loading.
+            /// \see setUtf8ErrorPolicy()
+            Utf8ErrorPolicy getUtf8ErrorPolicy(void) const;
+
+            /// Method to get the number of invalid UTF-8 sequences found during the last data loading.
+            /// \return number of invalid sequences.
+            /// \see getUtf8Errors()
+            size_t getUtf8ErrorCount(void) const;
+
+            /// Method to get the invalid UTF-8 sequences found during the last data loading, in file order (the first
+            /// 1000 sequences are recorded). Files loaded together are reported one after another.
+            /// \param t_target vector to store the offsets and kinds of the sequences in.
+            /// \see getUtf8ErrorCount()
+            /// \see setUtf8ErrorPolicy()
+            void getUtf8Errors(vector<Utf8Error> &t_target) const;
+
+            /// Method to select the policy for handling malformed rows (rows with a cell count different from the 
+            /// first row's). Optional method, loading stops with an exception by default. In quarantine mode, 
+            /// malformed rows are not stored (nor passed to row handlers and cursors), they are counted and recorded
+            /// with their row numbers, offsets and raw text instead (see getRowErrors()). If used, set it before 
+            /// triggering data loading.
+            /// \param t_policy policy to use.
+            /// \see getRowErrorPolicy()
+            void setRowErrorPolicy(const RowErrorPolicy t_policy);
+
+            /// Method to get the previously set policy for handling malformed rows.
+            /// \return policy used during data loading.
+            /// \see setRowErrorPolicy()
+            RowErrorPolicy getRowErrorPolicy(void) const;
+
+            /// Method to get the number of malformed rows left out during the last data loading (quarantine mode).
+            /// \return number of malformed rows.
+            /// \see getRowErrors()
+            size_t getRowErrorCount(void) const;
+
+            /// Method to get the malformed rows left out during the last data loading (quarantine mode), in file order 
+            /// (the first 1000 rows are recorded). Files loaded together are reported one after another, with row 
+            /// numbers and offsets in their own file.
+            /// \param t_target vector to store the row numbers, offsets and raw text of the rows in.
+            /// \see getRowErrorCount()
+            /// \see setRowErrorPolicy()
+            void getRowErrors(vector<RowError> &t_target) const;
+
+            /// Method to select how empty fields are stored. Optional method, they are stored as null cells by default 
+            /// (also passed to row handlers and cursors as empty strings). If used, set it before triggering data 
+            /// loading.
+            /// \param t_mode storage of empty fields.
+            /// \see getEmptyCellMode()
+            /// \see isNull()
+            void setEmptyCellMode(const EmptyCellMode t_mode);
+
+            /// Method to get the previously set storage of empty fields.
+            /// \return storage of empty fields used during data loading.
+            /// \see setEmptyCellMode()
+            EmptyCellMode getEmptyCellMode(void) const;
+
+            /// Method to select how null cells are handled by the typed data query methods. Optional method, null 
+            /// cells are converted from the null value by default.
+            /// \param t_policy policy to use.
+            /// \see getNullPolicy()
+            /// \see setNullValue()
+            void setNullPolicy(const NullPolicy t_policy);
+
+            /// Method to get the previously set null cell policy.
+            /// \return policy used by the typed data query methods.
+            /// \see setNullPolicy()
+            NullPolicy getNullPolicy(void) const;
+
+            /// Method to set the value null cells are converted from by the typed data query methods (e.g. "0" as
+            /// empty fields were returned by earlier versions, or "nan" for floating point columns). Optional method,
+            /// the value is empty by default (zero for numeric types).
+            /// \param t_value string value of null cells.
+            /// \see getNullValue()
+            /// \see setNullPolicy()
+            void setNullValue(const string &t_value);
+
+            /// Method to get the previously set value of null cells.
+            /// \return string value of null cells.
+            /// \see setNullValue()
+            string getNullValue(void) const;
+
+            /// Method to enable or disable validating the input as UTF-8 in bulk. Optional method, enabled by default:
+            /// chunks of input are validated before parsing, and the multibyte characters of valid chunks are copied
+            /// together with the bytes around them instead of character by character. Chunks with invalid sequences
+            /// are parsed character by character, the sequences are handled by the policy set (see 
+            /// setUtf8ErrorPolicy()). Disable it for trusted input (e.g. written by this library) to skip the 
+            /// validation pass, invalid sequences may be copied to the cells without being reported then. If used, 
+            /// set it before triggering data loading.
+            /// \param t_is_enabled true to validate the input, false to trust it.
+            /// \see getUtf8Validation()
+            void setUtf8Validation(const bool t_is_enabled);
+
+            /// Method to get whether the input is validated as UTF-8 in bulk.
+            /// \return true if the input is validated, false if it is trusted.
+            /// \see setUtf8Validation()
+            bool getUtf8Validation(void) const;
+
+            /// Method to set the number of buffers used in read-ahead mode (at least 2). One buffer is being parsed 
+            /// while the others can be filled by the I/O thread, more buffers help smoothing out I/O latency spikes.
+            /// In io_uring mode, it is the number of reads kept in flight while a block is parsed (fast devices need
+            /// deeper queues to be saturated).
+            /// Optional method, 2 buffers (double buffering) are used by default. If used, set it before triggering 
+            /// data loading.
+            /// \param t_buffer_count number of read buffers.
+            /// \see getBufferCount()
+            /// \see setBufferSize()
+            void setBufferCount(const size_t t_buffer_count);
+
+            /// Method to get the previously set number of buffers used in read-ahead mode.
+            /// \return number of read buffers.
+            /// \see setBufferCount()
+            size_t getBufferCount(void) const;
+
+            /// Method to get the time the parser spent waiting for data during the last data loading in read-ahead 
+            /// mode (or while loading compressed data, which is always read ahead). A value close to the total load
+            /// time indicates I/O bound loading, a value close to zero indicates CPU bound loading. The value is zero
+            /// in other cases.
+            /// \return waiting time in seconds.
+            /// \see setReadMode()
+            double getStallTime(void) const;
+
+            /// Method to set the number of threads loading files concurrently when loading multiple files, and parsing
+            /// the chunks of a large file in parallel (see setChunkSize()). Optional method, zero (default) means the
+            /// number of processors online, 1 turns parallel parsing off.
+            /// \param t_thread_count number of loading threads.
+            /// \see getThreadCount()
+            void setThreadCount(const size_t t_thread_count);
+
+            /// Method to get the previously set number of threads loading files concurrently.
+            /// \return number of loading threads (zero means the number of processors online).
+            /// \see setThreadCount()
+            size_t getThreadCount(void) const;
+
+            /// Method to set the minimum size of the chunks a file is split into for parallel parsing. Files of at 
+            /// least two chunks are split into as many chunks as there are threads (at most). The row boundaries are
+            /// found in the chunks concurrently first (row index), then the data structure is sized for the rows and 
+            /// the rows are parsed concurrently into their places, so the result is the same as parsing the file on
+            /// a single thread. Applies to uncompressed, seekable files loaded into the data structure in stdio or
+            /// read-ahead mode, without row skip or limit. Optional method, 16 MiB by default.
+            /// \param t_chunk_size minimum chunk size in bytes (not zero).
+            /// \see getChunkSize()
+            /// \see setThreadCount()
+            void setChunkSize(const size_t t_chunk_size);
+
+            /// Method to get the previously set minimum size of the chunks parsed in parallel.
+            /// \return minimum chunk size in bytes.
+            /// \see setChunkSize()
+            size_t getChunkSize(void) const;
+
+            /// Method to trigger data loading. Requires filename and delimiter to be set before calling it. Gzip and 
+            /// zstd compressed files are detected by their leading (magic) bytes and decompressed on the fly on a 
+            /// separate thread, regardless of the file extension. Large files are parsed on multiple threads (see 
+            /// setChunkSize()).
+            /// \return the number of records loaded (passed to the row handler in streaming mode).
             /// \see unloadData()
             size_t loadData(void);
 
+            /// \overload
+            /// Method to trigger data loading from a caller owned memory buffer instead of a file. The buffer is 
+            /// parsed in place (it is not copied), it must stay valid until the method returns. Compressed data is
+            /// detected and decompressed the same way as compressed files. Requires delimiter to be set before 
+            /// calling it, filename and read mode settings are not used.
+            /// \param t_data pointer to the first byte of the CSV data.
+            /// \param t_size number of bytes in the buffer.
+            /// \return the number of records loaded.
+            /// \see unloadData()
+            size_t loadData(const char *t_data, const size_t t_size);
+
+            /// \overload
+            /// Method to trigger data loading from a caller owned stdio stream (e.g. stdin or a popen() pipe), for 
+            /// inputs that cannot seek (pipes, FIFOs, sockets). The stream is read until its end, it is not closed. As 
+            /// the size of the input is not known in advance, the data structure is sized from the first block read
+            /// and grows geometrically (see SlightMatrix::setGrowthFactor()). Parsing is the same as for files, 
+            /// compressed streams are decompressed on the fly. Requires delimiter to be set before calling it, the 
+            /// filename setting is not used, mmap and io_uring read modes fall back to plain reads.
+            /// \param t_file stdio stream opened for reading.
+            /// \return the number of records loaded.
+            /// \see unloadData()
+            size_t loadData(FILE *t_file);
+
+            /// \overload
+            /// Method to trigger data loading from a caller owned file descriptor (e.g. 0 for the standard input), 
+            /// the same way as loading from a stdio stream. The descriptor is not closed.
+            /// \param t_fd file descriptor opened for reading.
+            /// \return the number of records loaded.
+            /// \see loadData(FILE *t_file)
+            size_t loadData(const int t_fd);
+
+            /// \overload
+            /// Method to trigger data loading from a standard input stream (e.g. std::cin), the same way as loading 
+            /// from a stdio stream.
+            /// \param t_stream input stream.
+            /// \return the number of records loaded.
+            /// \see loadData(FILE *t_file)
+            size_t loadData(std::istream &t_stream);
+
+            /// Method to load the rows appended to the file since the last data loading (incremental reload of growing
+            /// files, e.g. logs). Only the new bytes are parsed and the new rows are added to the loaded data (or 
+            /// passed to the row handler in streaming mode). All data is loaded again if the file was truncated or 
+            /// replaced (rotated) since, if it is compressed, or if no data was loaded from the file before. A last 
+            /// row without a terminating new line is parsed again, as it may have been continued (in streaming mode
+            /// it is passed to the row handler again). Row skip and limit settings are not applied to the appended rows.
+            /// \return the number of records loaded by the call.
+            /// \see loadData()
+            size_t reloadData(void);
+
+            /// \overload
+            /// Method to trigger data loading of multiple files with the same layout into one data structure (e.g. 
+            /// hourly files of a day). The files are parsed concurrently on a pool of threads, their rows are added in
+            /// the order of the list, so the result does not depend on thread scheduling. The column counts of the 
+            /// files must match. Header rows are loaded only once, from the first file (the other files must have the
+            /// same number of header rows, they are left out). Row skip and limit apply to the data rows of the files
+            /// together, as if they were one file: no more files are read once the limit is reached. In streaming 
+            /// mode, the files are parsed one after another on the calling thread. Requires delimiter to be set 
+            /// before calling it, the filename setting is not used.
+            /// \param t_filenames names and relative paths of the files.
+            /// \return the number of records loaded.
+            /// \see setThreadCount()
+            /// \see loadDataGlob()
+            size_t loadData(const vector<string> &t_filenames);
+
+            /// Method to trigger data loading of the files matching a wildcard pattern (e.g. "data/2018-01-01-*.csv"),
+            /// in alphabetical order of their names. The files are loaded the same way as a list of files.
+            /// \param t_pattern wildcard pattern of the file names (with relative path).
+            /// \return the number of records loaded.
+            /// \see loadData(const vector<string> &t_filenames)
+            size_t loadDataGlob(const string &t_pattern);
+
+            /// Method to trigger data loading of a byte range of the file (sharding, a file can be split among 
+            /// independent workers). Rows beginning within the range are loaded: the start is moved to the next row 
+            /// boundary (new lines inside escaped cells are not boundaries) and the last row crossing the end of the
+            /// range is loaded completely. Adjacent ranges load every row exactly once. Header rows at the beginning
+            /// of the file are loaded for every range. If escape character is set, the bytes before the range are 
+            /// scanned (not parsed) to find out the escape state at its start. Compressed files and read mode 
+            /// settings are not supported. Requires filename and delimiter to be set before calling it.
+            /// \param t_offset byte offset of the range from the beginning of the file.
+            /// \param t_length length of the range in bytes.
+            /// \return the number of records loaded (header rows included).
+            /// \see unloadData()
+            size_t loadDataRange(const size_t t_offset, const size_t t_length);
+
             /// Method to get the number of columns in the parsed data structure. Data is held in memory.
             /// \return column count in the parsed data structure.
             /// \see getRowCount()
@@ -127,22 +586,31 @@ namespace utils {
             /// \see getColumnCount()
             size_t getRowCount(void) const;
 
-            /// Method to override and set the number of header rows in the output of the parser. The library tries 
-            /// to detect and count header rows automatically.
+            /// Method to override and set the number of header rows in the output of the parser. The library 
+            /// recognizes header rows while loading (see setHeaderMode()).
             /// \param t_header_count the number of header rows at the beginning of the CSV file.
             /// \see getHeaderCount()
             void setHeaderCount(const size_t t_header_count);
 
             /// Method to get the number of header rows at the beginning of the parsed file. After loading the data 
-            /// it returns an automatically detected value which may be overridden by the user.
+            /// it returns the value recognized by the header policy, which may be overridden by the user.
             /// \return number of header rows at the beginning of the parsed file.
             /// \see setHeaderCount()
             size_t getHeaderCount(void) const;
 
+            /// Method to check whether a specific cell is null (an empty field stored without contents).
+            /// \param t_row_index index (starting from 0) of the row of the cell.
+            /// \param t_column_index index (starting from 0) of the column of the cell.
+            /// \return true if the cell is null, false otherwise.
+            /// \see setEmptyCellMode()
+            /// \see setNullPolicy()
+            bool isNull(const size_t t_row_index, const size_t t_column_index) const;
+
             /// Method to get the contents of a specific cell. The internal data structure stores cell values as strings.
             /// When using the method, the library tries to convert the string contents to the type supplied as the 
             /// first parameter of the method. Supported types: int, float, double, string. If conversion fails,
-            /// the value returned will be 0. In this case, it is always possible to get the value as string.
+            /// the value returned will be 0. In this case, it is always possible to get the value as string. Null 
+            /// cells are handled by the null policy (see setNullPolicy()).
             /// \param t_value variable to hold the value of the cell.
             /// \param t_row_index index (starting from 0) of the row the cell queried.
             /// \param t_column_index index (starting from 0) of the column holding the cell queried.
@@ -155,7 +623,8 @@ namespace utils {
             /// The internal data structure stores cell values as strings. When using the method, the library tries 
             /// to convert the string contents to the type held by the vector supplied as the method. Supported 
             /// types: int, float, double, string. If conversion fails, the value returned will be 0. In this case, 
-            /// it is always possible to get the value as string.
+            /// it is always possible to get the value as string. Null cells are handled by the null policy (see 
+            /// setNullPolicy()).
             /// \param t_target_column vector to hold the values of the cells in the column.
             /// \param t_column_index index (starting from 0) of the column to be returned.
             /// \see getRow()
@@ -195,7 +664,7 @@ namespace utils {
 
             /// Method to get the cells of a specific row. The row is represented in the form of a vector.
             /// The internal data structure stores cell values as strings. When using the method, the library
-            /// returns cells in a row as strings.
+            /// returns cells in a row as strings (null cells as empty strings).
             /// \param t_target_row vector to hold the values of the cells in the row.
             /// \param t_row_index index (starting from 0) of the row to be returned.
             /// \see getColumn()
@@ -237,12 +706,105 @@ namespace utils {
             void reset(void);
 
         private:
+            friend class SlightCursor;
+
+            void copySettings(const SlightCSV &t_source);
+            static void *loadFiles(void *t_job);
+            static void *loadChunks(void *t_job);
+            size_t loadFile(bool &t_is_seekable);
+            bool loadParallel(void);
+            size_t countEscapes(const size_t t_start, const size_t t_end);
+            void indexRows(const size_t t_start, const size_t t_end, const bool t_is_escaped, 
+                vector<size_t> &t_row_ends);
+            void loadChunk(const size_t t_start, const size_t t_end, SlightMatrix &t_target, const size_t t_first_row);
+            size_t loadSource(SlightInput &t_source, const bool t_read_ahead);
+            size_t loadInput(SlightInput &t_input);
+            size_t loadStream(SlightStreamInput &t_stream);
+            void beginParse(SlightInput &t_input);
+            void setupTables(void);
+            void resumeParse(SlightInput &t_input, const size_t t_offset, const size_t t_row_id, 
+                const bool t_is_escaped);
+            size_t findRowStart(SlightInput &t_input, const size_t t_position, const size_t t_offset, 
+                const bool t_is_escaped);
+            void saveReloadState(void);
+            bool parseRow(void);
+            size_t parseChunk(const char *t_data, const size_t t_size);
+            size_t findRun(const char *t_data, const size_t t_size, bool &t_is_escaped, size_t *t_digit_count) const;
+            template <char t_separator, char t_escape>
+            size_t parseDialect(const char *t_data, const size_t t_size);
+            void addToRow(const char *t_bytes, const size_t t_size);
+            void beginCell(void);
+            void endRow(void);
+            void updateHeaderDetection(void);
+            bool handleUtf8Error(const Utf8ErrorCode t_code, const size_t t_offset);
+            void clearUtf8Errors(void);
+            void appendUtf8Errors(const SlightCSV &t_source);
+            void keepRowText(void);
+            void setRowText(const size_t t_row_id, const size_t t_end);
+            void clearRowErrors(void);
+            void appendRowErrors(const SlightCSV &t_source, const size_t t_row_id);
+            bool getIsHeaderRow(const size_t t_row_id, const bool t_is_detected) const;
             void processRow(string &t_input, const size_t t_row_id);
+            void submitRow(const size_t t_row_size, const bool t_is_header, const size_t t_row_id);
 
             SlightCSVPrivate *m_csvp;
 
     };
 
+    /// Cursor class to iterate through the rows of a CSV file one by one (pull-based reading). The file is read 
+    /// incrementally with a fixed size buffer and only the current row is held in memory, so memory usage does not 
+    /// depend on the size of the file. Parsing settings (filename, delimiter, escape, strip and replace characters, 
+    /// buffer size) are taken from a SlightCSV object when opening the cursor. Compressed files are decompressed 
+    /// while reading.
+    class SlightCursor {
+
+        public:
+            /// The class's default constructor.
+            SlightCursor(void);
+
+            /// The class's default destructor. Closes the cursor if it is open.
+            ~SlightCursor(void);
+
+            /// Method to open the cursor. Settings are copied from the SlightCSV object supplied, later changes of 
+            /// the object do not affect the open cursor. Requires filename and delimiter to be set in the SlightCSV 
+            /// object. A previously opened cursor is closed first.
+            /// \param t_csv SlightCSV object holding the parsing settings.
+            /// \see close()
+            void open(const SlightCSV &t_csv);
+
+            /// Method to advance the cursor to the next row of the file. Header detection and cell count verification
+            /// are done the same way as during data loading.
+            /// \param t_target_row vector to hold the cells of the row.
+            /// \return false if the end of the file is reached (no more rows), true otherwise.
+            /// \see getRowIndex()
+            /// \see getIsHeader()
+            bool next(vector<string> &t_target_row);
+
+            /// Method to get the index of the current row (the one last returned by next()).
+            /// \return index (starting from 0) of the current row in the file, header rows included.
+            /// \see next()
+            size_t getRowIndex(void) const;
+
+            /// Method to verify if the current row (the one last returned by next()) is a header.
+            /// \return header flag of the current row.
+            /// \see next()
+            bool getIsHeader(void) const;
+
+            /// Method to close the cursor and release the file. Optional, cursors are closed on destruction as well.
+            /// \see open()
+            void close(void);
+
+        private:
+            SlightCursor(const SlightCursor &);
+            SlightCursor &operator=(const SlightCursor &);
+
+            SlightCSV m_parser;
+            SlightInput *m_source;
+            SlightInput *m_input;
+            bool m_has_row;
+
+    };
+
     /// Base exception of the class (never gets thrown). Inheriting from std::exception.
     class slightcsv_error: public exception {};
 
@@ -303,7 +865,63 @@ namespace utils {
     };
 
     /// Exception inheriting from slightcsv_error. It is thrown when:
-    /// - the CSV file format is invalid (inconsistency in terms of cell quantity in a row)
+    /// - trying to set zero read buffer size
+    /// - trying to set zero chunk size
+    /// - trying to set less than 2 read buffers
+    /// - trying to load data from a null buffer
+    class slightcsv_buffer_error: public slightcsv_error {
+
+        const char* what() const throw() {
+            return "Buffer size invalid.";
+        }
+
+    };
+
+    /// Exception inheriting from slightcsv_error. It is thrown when:
+    /// - trying to load data from a null stdio stream, a negative file descriptor or a failed input stream
+    class slightcsv_stream_error: public slightcsv_error {
+
+        const char* what() const throw() {
+            return "Input stream invalid.";
+        }
+
+    };
+
+    /// Exception inheriting from slightcsv_error. It is thrown when:
+    /// - trying to load a byte range of zero length
+    class slightcsv_range_error: public slightcsv_error {
+
+        const char* what() const throw() {
+            return "Byte range invalid.";
+        }
+
+    };
+
+    /// Exception inheriting from slightcsv_error. It is thrown when:
+    /// - the data is compressed in a format the library was built without support for
+    /// - trying to load a byte range of compressed data
+    class slightcsv_compression_error: public slightcsv_error {
+
+        const char* what() const throw() {
+            return "Compression format not supported.";
+        }
+
+    };
+
+    /// Exception inheriting from slightcsv_error. It is thrown when:
+    /// - advancing a cursor which is not open
+    /// - querying the current row of a cursor which is not positioned on a row
+    class slightcsv_cursor_error: public slightcsv_error {
+
+        const char* what() const throw() {
+            return "Cursor not open or not positioned on a row.";
+        }
+
+    };
+
+    /// Exception inheriting from slightcsv_error. It is thrown when:
+    /// - the CSV file format is invalid (inconsistency in terms of cell quantity in a row), unless malformed rows are 
+    /// quarantined (see SlightCSV::setRowErrorPolicy())
     /// - settings of the parser cause the CSV file format to seem invalid (as a consequence of character manipulation 
     /// with escape, strip and replace)
     class slightcsv_format_cellcnt_error: public slightcsv_error {
@@ -345,6 +963,16 @@ namespace utils {
 
     };
 
+    /// Exception inheriting from slightcsv_error. It is thrown when:
+    /// - querying the value of a null cell with the throwing null policy
+    class slightcsv_null_error: public slightcsv_error {
+
+        const char* what() const throw() {
+            return "Null cell (no value).";
+        }
+
+    };
+
     /// Exception inheriting from slightcsv_error. It is thrown when:
     /// - file read error occurred before reaching the end of file (EOF)
     class slightcsv_read_error: public slightcsv_error {
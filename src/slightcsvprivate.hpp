@@ -22,8 +22,12 @@
 #include <set>
 #include <map>
 
+#include "slightcsv.hpp"
 #include "slightmatrix.hpp"
 #include "slightrow.hpp"
+#include "slightinput.hpp"
+#include "slightscan.hpp"
+#include "slightdfa.hpp"
 #include "u8char.hpp"
 
 using std::string;
@@ -47,6 +51,99 @@ namespace utils {
             map<U8char, U8char> m_rep_chars;
             SlightRow m_row;
             size_t m_file_size;
+            SlightCSV::ReadMode m_read_mode;
+            size_t m_buffer_size;
+            size_t m_buffer_count;
+            size_t m_thread_count;
+            size_t m_min_chunk_size;
+            double m_stall_time;
+            SlightRowHandler *m_row_handler;
+            size_t m_handled_row_count;
+            vector<string> m_cells;
+            SlightCSV::EmptyCellMode m_empty_cell_mode;
+            SlightCSV::HeaderMode m_header_mode;
+            size_t m_header_row_count;
+            // header detection of the current row (numeric characters counted)
+            bool m_header_detect_enabled;
+            size_t m_row_skip;
+            size_t m_row_limit;
+            size_t m_data_row_count;
+            bool m_row_limits_active;
+            bool m_row_skipped;
+            bool m_cursor_mode;
+            size_t m_cursor_row_id;
+            // parallel loading (rows written into the data matrix of the caller from the given row on)
+            SlightMatrix *m_slot_matrix;
+            size_t m_slot_row;
+            // parser state (kept between input chunks)
+            U8char m_in_u8_char;
+            string m_in_line;
+            bool m_is_escaped;
+            SlightScanner m_scanner;
+            bool m_scan_enabled;
+            // scanner passing over multibyte characters as well, used in the byte range of the current chunk 
+            // validated as UTF-8 (without the characters split between chunks)
+            SlightScanner m_text_scanner;
+            bool m_text_scan_enabled;
+            SlightUtf8Validator m_validator;
+            bool m_utf8_validation;
+            const char *m_trusted_begin;
+            const char *m_trusted_end;
+            SlightDfa m_dfa;
+            bool m_dfa_enabled;
+            // rows split into cells while parsing, without a line buffer (cell machine state, current cell index, size
+            // and numeric character count of the current row)
+            SlightDfa m_cell_dfa;
+            bool m_fused_enabled;
+            SlightDfa::State m_cell_state;
+            size_t m_cell_index;
+            size_t m_row_size;
+            size_t m_digit_count;
+            bool m_row_is_header;
+            // invalid UTF-8 sequences (recorded while parsing, handled by the policy)
+            SlightCSV::Utf8ErrorPolicy m_utf8_policy;
+            vector<SlightCSV::Utf8Error> m_utf8_errors;
+            size_t m_utf8_error_count;
+            // parsing stopped at an invalid UTF-8 sequence
+            bool m_utf8_failed;
+            // malformed rows (recorded with the raw text of the row, assembled from the part kept from earlier chunks 
+            // and the current chunk)
+            SlightCSV::RowErrorPolicy m_row_policy;
+            vector<SlightCSV::RowError> m_row_errors;
+            size_t m_row_error_count;
+            bool m_row_rejected;
+            string m_row_text;
+            size_t m_row_text_offset;
+            // parser specialized for the separator and escape characters (common dialects without strip and replace
+            // rules, zero otherwise)
+            size_t (SlightCSV::*m_dialect_parser)(const char *t_data, const size_t t_size);
+            size_t m_row_id;
+            bool m_bom_found;
+            SlightInput *m_input;
+            const char *m_chunk;
+            size_t m_chunk_size;
+            size_t m_chunk_offset;
+            // input position (byte offset of the current chunk, end of the last row terminated by a new line)
+            size_t m_chunk_base;
+            size_t m_row_end_offset;
+            bool m_row_end_escaped;
+            bool m_tail_row;
+            bool m_compressed;
+            // byte range loading (end offset of the range, zero if not set)
+            size_t m_range_end;
+            bool m_parse_done;
+            bool m_row_started;
+            bool m_headers_only;
+            // incremental reload state (file identity and position reached by the last data loading)
+            bool m_reload_valid;
+            string m_reload_filename;
+            unsigned long m_reload_file_id;
+            string m_reload_head;
+            size_t m_reload_offset;
+            size_t m_reload_row_id;
+            bool m_reload_escaped;
+            bool m_reload_bom_found;
+            bool m_reload_tail;
 
     };
 
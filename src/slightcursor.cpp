@@ -0,0 +1,114 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "slightcsv.hpp"
+#include "slightcsvprivate.hpp"
+#include "slightinput.hpp"
+
+using utils::SlightFileInput;
+using utils::SlightDecompressInput;
+
+utils::SlightCursor::SlightCursor(void) {
+    m_source = 0;
+    m_input = 0;
+    m_has_row = false;
+}
+
+utils::SlightCursor::~SlightCursor(void) {
+    this->close();
+}
+
+void utils::SlightCursor::open(const SlightCSV &t_csv) {
+
+    if (!t_csv.m_csvp->m_filename.size()) {
+        throw slightcsv_filename_error();
+    }
+
+    if (!t_csv.m_csvp->m_separator) {
+        throw slightcsv_separator_error();
+    }
+
+    this->close();
+
+    // set up the cursor's own parser (rows are not stored, only the current one is kept)
+    m_parser.reset();
+    m_parser.copySettings(t_csv);
+    m_parser.m_csvp->m_cursor_mode = true;
+
+    // open file for incremental reading
+    SlightFileInput *in_file = new SlightFileInput;
+    in_file->setBufferSize(m_parser.m_csvp->m_buffer_size);
+    try {
+        in_file->open(m_parser.m_csvp->m_filename);
+    } catch (const slightinput_open_error &e) {
+        delete in_file;
+        throw slightcsv_filename_error();
+    }
+    m_source = in_file;
+
+    // compressed files are decompressed while reading
+    SlightDecompressInput *in_decompress = new SlightDecompressInput;
+    in_decompress->setBufferSize(m_parser.m_csvp->m_buffer_size);
+    try {
+        in_decompress->open(*m_source);
+    } catch (const slightinput_unsupported_error &e) {
+        delete in_decompress;
+        this->close();
+        throw slightcsv_compression_error();
+    } catch (const slightinput_error &e) {
+        delete in_decompress;
+        this->close();
+        throw slightcsv_read_error();
+    }
+    m_input = in_decompress;
+
+    m_parser.beginParse(*m_input);
+}
+
+bool utils::SlightCursor::next(vector<string> &t_target_row) {
+    if (!m_input) {
+        throw slightcsv_cursor_error();
+    }
+    m_has_row = m_parser.parseRow();
+    if (m_has_row) {
+        t_target_row = m_parser.m_csvp->m_cells;
+    }
+    return m_has_row;
+}
+
+size_t utils::SlightCursor::getRowIndex(void) const {
+    if (!m_has_row) {
+        throw slightcsv_cursor_error();
+    }
+    return m_parser.m_csvp->m_cursor_row_id;
+}
+
+bool utils::SlightCursor::getIsHeader(void) const {
+    if (!m_has_row) {
+        throw slightcsv_cursor_error();
+    }
+    return m_parser.m_csvp->m_row_is_header;
+}
+
+void utils::SlightCursor::close(void) {
+    // detach input from the parser before releasing it
+    m_parser.m_csvp->m_input = 0;
+    delete m_input;
+    m_input = 0;
+    delete m_source;
+    m_source = 0;
+    m_has_row = false;
+}
@@ -0,0 +1,259 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "slightdfa.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+// get the single byte of an ASCII character, false for multibyte characters
+static bool getAsciiByte(const U8char &t_char, unsigned char &t_byte) {
+    if (t_char.size() != 1) {
+        return false;
+    }
+    t_byte = t_char.getByte(0);
+    return !(t_byte & 0x80);
+}
+
+// length of a UTF-8 character from its first byte (zero if the byte cannot be the first one)
+static size_t getLengthFromByte(const unsigned char t_byte) {
+    if (t_byte < 0x80) {
+        return 1;
+    }
+    if ((t_byte & 0xe0) == 0xc0) {
+        return 2;
+    }
+    if ((t_byte & 0xf0) == 0xe0) {
+        return 3;
+    }
+    if ((t_byte & 0xf8) == 0xf0) {
+        return 4;
+    }
+    return 0;
+}
+
+utils::SlightDfa::SlightDfa(void) {
+    memset(m_transitions, 0, sizeof(m_transitions));
+    memset(m_byte_rules, RULE_NONE, sizeof(m_byte_rules));
+    m_replacements.resize(256);
+    m_multibyte_rule_count = 0;
+    m_hash_factor = 0;
+    m_hash_shift = 0;
+}
+
+bool utils::SlightDfa::setupRows(const U8char &t_escape, const set<U8char> &t_strip_chars,
+    const map<U8char, U8char> &t_rep_chars) {
+
+    setupRules(t_strip_chars, t_rep_chars);
+
+    unsigned char escape = 0;
+    bool has_escape = t_escape.size() > 0;
+    if (has_escape && !getAsciiByte(t_escape, escape)) {
+        return false;
+    }
+
+    // the same decisions as the character by character parsing, made once for every state and byte
+    const State states[] = {STATE_FIELD, STATE_QUOTED};
+    for (size_t s = 0; s < 2; ++s) {
+        for (unsigned byte = 0; byte < 0x80; ++byte) {
+            bool is_escaped = states[s] == STATE_QUOTED;
+            // stripped characters are dropped before anything else (even the escape character)
+            if (m_byte_rules[byte] == RULE_STRIP) {
+                setTransition(states[s], byte, ACTION_SKIP, states[s]);
+                continue;
+            }
+            if (has_escape && byte == escape) {
+                is_escaped ^= true;
+            }
+            State next = is_escaped ? STATE_QUOTED : STATE_FIELD;
+            if ((byte != '\r' && byte != '\n') || is_escaped) {
+                // NUL bytes are not added to the row
+                Action action = m_byte_rules[byte] == RULE_REPLACE ? ACTION_REPLACE : 
+                    (byte ? ACTION_COPY : ACTION_SKIP);
+                setTransition(states[s], byte, action, next);
+            } else {
+                setTransition(states[s], byte, ACTION_ROW_END, next);
+            }
+        }
+        setupMultibyte(states[s], states[s]);
+    }
+    return true;
+}
+
+bool utils::SlightDfa::setupCells(const U8char &t_separator, const U8char &t_escape) {
+
+    unsigned char separator;
+    if (!getAsciiByte(t_separator, separator)) {
+        return false;
+    }
+    unsigned char escape = 0;
+    bool has_escape = t_escape.size() > 0;
+    if (has_escape && !getAsciiByte(t_escape, escape)) {
+        return false;
+    }
+
+    // the same decisions as the character by character processing, made once for every state and byte
+    for (int s = 0; s < STATE_COUNT; ++s) {
+        State state = (State)s;
+        bool is_empty = state == STATE_EMPTY || state == STATE_AFTER_SEPARATOR;
+        for (unsigned byte = 0; byte < 0x80; ++byte) {
+            bool is_escaped = state == STATE_QUOTED;
+            if (has_escape && byte == escape) {
+                is_escaped ^= true;
+            }
+            if (byte != separator || is_escaped) {
+                if (!byte) {
+                    // NUL bytes are not added to the cell, but a separator is not the last character any more
+                    setTransition(state, byte, ACTION_SKIP, state == STATE_AFTER_SEPARATOR ? STATE_EMPTY : state);
+                } else {
+                    setTransition(state, byte, ACTION_COPY, is_escaped ? STATE_QUOTED : STATE_FIELD);
+                }
+            } else {
+                setTransition(state, byte, is_empty ? ACTION_EMPTY_CELL : ACTION_CELL_END, STATE_AFTER_SEPARATOR);
+            }
+        }
+        setupMultibyte(state, state == STATE_QUOTED ? STATE_QUOTED : STATE_FIELD);
+    }
+    return true;
+}
+
+void utils::SlightDfa::setupRules(const set<U8char> &t_strip_chars, const map<U8char, U8char> &t_rep_chars) {
+    memset(m_byte_rules, RULE_NONE, sizeof(m_byte_rules));
+    for (size_t i = 0; i < m_replacements.size(); ++i) {
+        m_replacements[i].clear();
+    }
+    vector<MultibyteRule> rules;
+    // replaced characters first, as stripping takes precedence
+    for (map<U8char, U8char>::const_iterator it = t_rep_chars.begin(); it != t_rep_chars.end(); ++it) {
+        char bytes[5] = {0};
+        it->second.getBytes(bytes, 4);
+        if (it->first.size() == 1) {
+            m_byte_rules[(unsigned char)it->first.getByte(0)] = RULE_REPLACE;
+            m_replacements[(unsigned char)it->first.getByte(0)] = bytes;
+        } else {
+            char key[5] = {0};
+            it->first.getBytes(key, 4);
+            MultibyteRule rule;
+            rule.m_key = getKey(key, it->first.size());
+            rule.m_rule = RULE_REPLACE;
+            rule.m_replacement = bytes;
+            rules.push_back(rule);
+        }
+    }
+    for (set<U8char>::const_iterator it = t_strip_chars.begin(); it != t_strip_chars.end(); ++it) {
+        if (it->size() == 1) {
+            m_byte_rules[(unsigned char)it->getByte(0)] = RULE_STRIP;
+            m_replacements[(unsigned char)it->getByte(0)].clear();
+        } else {
+            char key[5] = {0};
+            it->getBytes(key, 4);
+            MultibyteRule rule;
+            rule.m_key = getKey(key, it->size());
+            rule.m_rule = RULE_STRIP;
+            // a replaced character stripped off as well
+            size_t i = 0;
+            while (i < rules.size() && rules[i].m_key != rule.m_key) {
+                ++i;
+            }
+            if (i == rules.size()) {
+                rules.push_back(rule);
+            } else {
+                rules[i] = rule;
+            }
+        }
+    }
+    setupMultibyteRules(rules);
+}
+
+void utils::SlightDfa::setupMultibyteRules(const vector<MultibyteRule> &t_rules) {
+    m_multibyte_rule_count = t_rules.size();
+    m_multibyte_rules.clear();
+    if (t_rules.empty()) {
+        return;
+    }
+
+    // find a multiplier mapping every key to a different slot (keys are distinct, so an odd multiplier is a bijection
+    // of 32-bit numbers and the search always ends), the table is kept at most about half full
+    unsigned bits = 1;
+    while (((size_t)1 << bits) < 2 * t_rules.size()) {
+        ++bits;
+    }
+    uint32_t factor = 0x9e3779b1u;
+    for (;;) {
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            vector<MultibyteRule> table((size_t)1 << bits);
+            bool is_perfect = true;
+            for (size_t i = 0; i < t_rules.size() && is_perfect; ++i) {
+                MultibyteRule &slot = table[(uint32_t)(t_rules[i].m_key * factor) >> (32 - bits)];
+                // an empty slot has key zero (not a valid multibyte character)
+                is_perfect = !slot.m_key;
+                slot = t_rules[i];
+            }
+            if (is_perfect) {
+                m_multibyte_rules.swap(table);
+                m_hash_factor = factor;
+                m_hash_shift = 32 - bits;
+                return;
+            }
+            factor = (factor * 1664525u + 1013904223u) | 1;
+        }
+        ++bits;
+    }
+}
+
+size_t utils::SlightDfa::getCharLength(const char *t_data, const size_t t_size) {
+    size_t length;
+    U8char::Status status = checkChar(t_data, t_size, length);
+    if (status == U8char::STATUS_INCOMPLETE) {
+        return 0;
+    }
+    if (status != U8char::STATUS_VALID) {
+        throw u8char_format_error();
+    }
+    return length;
+}
+
+utils::U8char::Status utils::SlightDfa::checkChar(const char *t_data, const size_t t_size, size_t &t_length) {
+    t_length = getLengthFromByte(t_data[0]);
+    if (!t_length) {
+        t_length = 1;
+        return U8char::STATUS_INVALID_LEAD;
+    }
+    // the continuation bytes available are checked even if the character is incomplete
+    size_t available = std::min(t_length, t_size);
+    for (size_t i = 1; i < available; ++i) {
+        if ((t_data[i] & 0xc0) != 0x80) {
+            t_length = i;
+            return U8char::STATUS_INVALID_CONTINUATION;
+        }
+    }
+    return t_length > t_size ? U8char::STATUS_INCOMPLETE : U8char::STATUS_VALID;
+}
+
+void utils::SlightDfa::setTransition(const State t_state, const unsigned char t_byte, const Action t_action,
+    const State t_next) {
+    m_transitions[t_state][t_byte] = (unsigned char)((t_action << 2) | t_next);
+}
+
+void utils::SlightDfa::setupMultibyte(const State t_state, const State t_next) {
+    for (unsigned byte = 0x80; byte < 0x100; ++byte) {
+        if (getLengthFromByte(byte) > 1) {
+            setTransition(t_state, byte, ACTION_MULTIBYTE, t_next);
+        } else {
+            setTransition(t_state, byte, ACTION_ERROR, t_state);
+        }
+    }
+}
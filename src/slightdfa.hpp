@@ -0,0 +1,206 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef _UTILS_SLIGHTDFA_HPP
+#define _UTILS_SLIGHTDFA_HPP
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <stdint.h>
+
+#include "u8char.hpp"
+
+using std::string;
+using std::vector;
+using std::set;
+using std::map;
+using utils::U8char;
+
+namespace utils {
+
+    /// Byte level state machine of the parser. The transitions (next state and action for each state and input byte)
+    /// are precomputed from the parser settings, so a byte is processed with a single table lookup instead of
+    /// assembling and comparing UTF-8 characters. The row machine splits the input into rows (new lines outside
+    /// escaped regions, stripped and replaced characters), the cell machine splits rows into cells. Separator and
+    /// escape characters have to be single byte (ASCII) characters, the bytes of multibyte characters are passed as a
+    /// whole. Strip and replace rules of multibyte characters are looked up in a perfect hash table (one multiplication
+    /// and one comparison per character).
+    class SlightDfa {
+
+        public:
+            /// States of the machines.
+            enum State {
+                /// Inside a row or cell, not escaped.
+                STATE_FIELD,
+                /// Inside an escaped region.
+                STATE_QUOTED,
+                /// Cell machine only: at the beginning of the row, nothing added to the cell yet.
+                STATE_EMPTY,
+                /// Cell machine only: right after a separator, nothing added to the cell yet.
+                STATE_AFTER_SEPARATOR,
+                STATE_COUNT
+            };
+
+            /// Actions of the transitions.
+            enum Action {
+                /// Add the byte to the row or cell.
+                ACTION_COPY,
+                /// Drop the byte (stripped character or NUL).
+                ACTION_SKIP,
+                /// Add the replacement of the byte.
+                ACTION_REPLACE,
+                /// Row machine only: the byte ends the row.
+                ACTION_ROW_END,
+                /// Cell machine only: the byte ends a (non-empty) cell.
+                ACTION_CELL_END,
+                /// Cell machine only: the byte ends an empty cell.
+                ACTION_EMPTY_CELL,
+                /// First byte of a multibyte character, to be added as a whole.
+                ACTION_MULTIBYTE,
+                /// Byte cannot start a UTF-8 character.
+                ACTION_ERROR
+            };
+
+            /// Strip and replace rules of characters.
+            enum Rule {
+                /// Character kept as it is.
+                RULE_NONE,
+                /// Character stripped off.
+                RULE_STRIP,
+                /// Character replaced.
+                RULE_REPLACE
+            };
+
+            /// Default constructor of the class. The machine is not set up.
+            SlightDfa(void);
+
+            /// Method to set up the row machine.
+            /// \param t_escape escape character (may be empty).
+            /// \param t_strip_chars characters to be stripped off.
+            /// \param t_rep_chars characters to be replaced and their replacements.
+            /// \return false if a setting cannot be handled by the machine (multibyte escape character), true otherwise.
+            /// The strip and replace rules are set up in both cases (see getRule()).
+            bool setupRows(const U8char &t_escape, const set<U8char> &t_strip_chars,
+                const map<U8char, U8char> &t_rep_chars);
+
+            /// Method to set up the cell machine.
+            /// \param t_separator delimiter character.
+            /// \param t_escape escape character (may be empty).
+            /// \return false if a setting cannot be handled by the machine (multibyte character), true otherwise.
+            bool setupCells(const U8char &t_separator, const U8char &t_escape);
+
+            /// Method to get the action of a transition.
+            /// \param t_state current state.
+            /// \param t_byte input byte.
+            /// \return action to take.
+            Action getAction(const State t_state, const char t_byte) const {
+                return (Action)(m_transitions[t_state][(unsigned char)t_byte] >> 2);
+            }
+
+            /// Method to get the next state of a transition.
+            /// \param t_state current state.
+            /// \param t_byte input byte.
+            /// \return next state.
+            State getNext(const State t_state, const char t_byte) const {
+                return (State)(m_transitions[t_state][(unsigned char)t_byte] & 3);
+            }
+
+            /// Method to get the replacement of a byte (row machine).
+            /// \param t_byte replaced byte.
+            /// \return bytes of the replacement character.
+            const string &getReplacement(const char t_byte) const {
+                return m_replacements[(unsigned char)t_byte];
+            }
+
+            /// Method to get the strip or replace rule of a character (row machine settings).
+            /// \param t_bytes pointer to the first byte of the character.
+            /// \param t_length number of bytes of the character.
+            /// \param t_replacement set to the bytes of the replacement character if the character is replaced.
+            /// \return rule of the character.
+            Rule getRule(const char *t_bytes, const size_t t_length, const string *&t_replacement) const {
+                if (t_length == 1) {
+                    t_replacement = &m_replacements[(unsigned char)*t_bytes];
+                    return (Rule)m_byte_rules[(unsigned char)*t_bytes];
+                }
+                if (!m_multibyte_rule_count) {
+                    return RULE_NONE;
+                }
+                uint32_t key = getKey(t_bytes, t_length);
+                const MultibyteRule &rule = m_multibyte_rules[(uint32_t)(key * m_hash_factor) >> m_hash_shift];
+                if (rule.m_key != key) {
+                    return RULE_NONE;
+                }
+                t_replacement = &rule.m_replacement;
+                return rule.m_rule;
+            }
+
+            /// Method to check if there are strip or replace rules for multibyte characters.
+            /// \return true if there are multibyte rules, false otherwise.
+            bool hasMultibyteRules(void) const {
+                return m_multibyte_rule_count != 0;
+            }
+
+            /// Method to get the length of the multibyte character beginning at the given byte, checking its
+            /// continuation bytes. Throws u8char_format_error if the character is malformed.
+            /// \param t_data pointer to the first byte of the character.
+            /// \param t_size number of bytes available.
+            /// \return number of bytes of the character, zero if not all of them are available.
+            static size_t getCharLength(const char *t_data, const size_t t_size);
+
+            /// Method to check the character beginning at the given byte without throwing exceptions.
+            /// \param t_data pointer to the first byte of the character.
+            /// \param t_size number of bytes available.
+            /// \param t_length set to the number of bytes of the character, or to the number of bytes of the invalid
+            /// sequence (up to the byte breaking it, at least one byte).
+            /// \return status of the character (U8char::STATUS_INCOMPLETE if not all of its bytes are available).
+            static U8char::Status checkChar(const char *t_data, const size_t t_size, size_t &t_length);
+
+        private:
+            struct MultibyteRule {
+                uint32_t m_key;
+                Rule m_rule;
+                string m_replacement;
+            };
+
+            static uint32_t getKey(const char *t_bytes, const size_t t_length) {
+                uint32_t key = 0;
+                for (size_t i = 0; i < t_length; ++i) {
+                    key |= (uint32_t)(unsigned char)t_bytes[i] << (i * 8);
+                }
+                return key;
+            }
+
+            void setupRules(const set<U8char> &t_strip_chars, const map<U8char, U8char> &t_rep_chars);
+            void setupMultibyteRules(const vector<MultibyteRule> &t_rules);
+            void setTransition(const State t_state, const unsigned char t_byte, const Action t_action,
+                const State t_next);
+            void setupMultibyte(const State t_state, const State t_next);
+
+            unsigned char m_transitions[STATE_COUNT][256];
+            unsigned char m_byte_rules[256];
+            vector<string> m_replacements;
+            vector<MultibyteRule> m_multibyte_rules;
+            size_t m_multibyte_rule_count;
+            uint32_t m_hash_factor;
+            unsigned m_hash_shift;
+
+    };
+
+} // utils
+
+#endif // _UTILS_SLIGHTDFA_HPP
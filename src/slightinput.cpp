@@ -0,0 +1,1300 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "slightinput.hpp"
+
+#include <sys/time.h>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// io_uring is used through raw system calls (no liburing dependency)
+#ifdef SLIGHTCSV_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#ifndef __NR_io_uring_setup
+#undef SLIGHTCSV_IO_URING
+#endif
+#endif
+
+// compression libraries are optional, sources in a format without library support are rejected on open
+#ifdef SLIGHTCSV_ZLIB
+#include <zlib.h>
+#endif
+#ifdef SLIGHTCSV_ZSTD
+#include <zstd.h>
+#endif
+
+// default size of the file read buffer (1 MiB)
+static const size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+// default size of the memory mapping window (64 MiB)
+static const size_t DEFAULT_WINDOW_SIZE = 64 * 1024 * 1024;
+
+// default number of read-ahead buffers (double buffering)
+static const size_t DEFAULT_BUFFER_COUNT = 2;
+
+// number of leading bytes needed to detect the compression format
+static const size_t MAGIC_SIZE = 4;
+
+// magic bytes of gzip members and zstd frames
+static const unsigned char GZIP_MAGIC[] = { 0x1f, 0x8b };
+static const unsigned char ZSTD_MAGIC[] = { 0x28, 0xb5, 0x2f, 0xfd };
+
+// get current time in seconds
+static double getTime(void) {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+utils::SlightInput::~SlightInput(void) {
+}
+
+utils::SlightMemoryInput::SlightMemoryInput(void) {
+    this->close();
+}
+
+void utils::SlightMemoryInput::open(const char *t_data, const size_t t_size) {
+    if (!t_data && t_size) {
+        throw slightinput_open_error();
+    }
+    m_data = t_data;
+    m_size = t_size;
+    m_read_done = false;
+}
+
+bool utils::SlightMemoryInput::read(const char *&t_data, size_t &t_size) {
+    // the whole buffer is returned as one chunk
+    if (m_read_done || !m_size) {
+        return false;
+    }
+    t_data = m_data;
+    t_size = m_size;
+    m_read_done = true;
+    return true;
+}
+
+size_t utils::SlightMemoryInput::getSize(void) const {
+    return m_size;
+}
+
+void utils::SlightMemoryInput::close(void) {
+    m_data = 0;
+    m_size = 0;
+    m_read_done = false;
+}
+
+utils::SlightFileInput::SlightFileInput(void) {
+    m_file = 0;
+    m_size = 0;
+    m_is_seekable = false;
+    m_buffer_size = DEFAULT_BUFFER_SIZE;
+}
+
+utils::SlightFileInput::~SlightFileInput(void) {
+    this->close();
+}
+
+void utils::SlightFileInput::setBufferSize(const size_t t_buffer_size) {
+    if (!t_buffer_size) {
+        throw slightinput_parameter_error();
+    }
+    m_buffer_size = t_buffer_size;
+}
+
+size_t utils::SlightFileInput::getBufferSize(void) const {
+    return m_buffer_size;
+}
+
+void utils::SlightFileInput::open(const string &t_filename) {
+    this->close();
+
+    m_file = fopen(t_filename.c_str(), "rb");
+    if (!m_file) {
+        throw slightinput_open_error();
+    }
+    // blocks are read into our own buffer, stream buffering would only add an extra copy
+    setvbuf(m_file, 0, _IONBF, 0);
+
+    // get file size (pipes and FIFOs cannot seek, their size is not known)
+    long size = -1;
+    if (fseek(m_file, 0L, SEEK_END) == 0) {
+        size = ftell(m_file);
+    }
+    m_is_seekable = size >= 0 && fseek(m_file, 0L, SEEK_SET) == 0;
+    m_size = m_is_seekable ? (size_t)size : 0;
+
+    // (re)allocate read buffer only if its size changed
+    if (m_buffer.size() != m_buffer_size) {
+        vector<char>(m_buffer_size).swap(m_buffer);
+    }
+}
+
+void utils::SlightFileInput::seek(const size_t t_offset) {
+    if (!m_file || !m_is_seekable || t_offset > m_size) {
+        throw slightinput_parameter_error();
+    }
+    if (fseek(m_file, (long)t_offset, SEEK_SET) != 0) {
+        throw slightinput_read_error();
+    }
+}
+
+unsigned long utils::SlightFileInput::getFileId(void) const {
+#ifndef _WIN32
+    struct stat file_stat;
+    if (m_file && fstat(fileno(m_file), &file_stat) == 0) {
+        return (unsigned long)file_stat.st_ino;
+    }
+#endif
+    return 0;
+}
+
+bool utils::SlightFileInput::getIsSeekable(void) const {
+    return m_is_seekable;
+}
+
+bool utils::SlightFileInput::read(const char *&t_data, size_t &t_size) {
+    if (!m_file) {
+        return false;
+    }
+    size_t read_count = fread(&m_buffer[0], 1, m_buffer.size(), m_file);
+    if (!read_count) {
+        if (ferror(m_file)) {
+            throw slightinput_read_error();
+        }
+        return false;
+    }
+    t_data = &m_buffer[0];
+    t_size = read_count;
+    return true;
+}
+
+size_t utils::SlightFileInput::getSize(void) const {
+    return m_size;
+}
+
+void utils::SlightFileInput::close(void) {
+    if (m_file) {
+        fclose(m_file);
+    }
+    m_file = 0;
+    m_size = 0;
+    m_is_seekable = false;
+}
+
+utils::SlightStreamInput::SlightStreamInput(void) {
+    m_file = 0;
+    m_fd = -1;
+    m_stream = 0;
+    m_buffer_size = DEFAULT_BUFFER_SIZE;
+}
+
+void utils::SlightStreamInput::setBufferSize(const size_t t_buffer_size) {
+    if (!t_buffer_size) {
+        throw slightinput_parameter_error();
+    }
+    m_buffer_size = t_buffer_size;
+}
+
+size_t utils::SlightStreamInput::getBufferSize(void) const {
+    return m_buffer_size;
+}
+
+void utils::SlightStreamInput::open(FILE *t_file) {
+    this->close();
+    if (!t_file) {
+        throw slightinput_open_error();
+    }
+    m_file = t_file;
+    allocateBuffer();
+}
+
+void utils::SlightStreamInput::open(const int t_fd) {
+    this->close();
+#ifndef _WIN32
+    if (t_fd < 0) {
+        throw slightinput_open_error();
+    }
+    m_fd = t_fd;
+    allocateBuffer();
+#else
+    throw slightinput_unsupported_error();
+#endif
+}
+
+void utils::SlightStreamInput::open(std::istream &t_stream) {
+    this->close();
+    if (!t_stream.good()) {
+        throw slightinput_open_error();
+    }
+    m_stream = &t_stream;
+    allocateBuffer();
+}
+
+bool utils::SlightStreamInput::read(const char *&t_data, size_t &t_size) {
+    size_t read_count = 0;
+    if (m_file) {
+        read_count = fread(&m_buffer[0], 1, m_buffer.size(), m_file);
+        if (!read_count && ferror(m_file)) {
+            throw slightinput_read_error();
+        }
+    } else if (m_stream) {
+        m_stream->read(&m_buffer[0], m_buffer.size());
+        read_count = m_stream->gcount();
+        if (!read_count && m_stream->bad()) {
+            throw slightinput_read_error();
+        }
+    }
+#ifndef _WIN32
+    else if (m_fd >= 0) {
+        // pipes return the bytes available so far, a short read is not the end of the input
+        ssize_t result;
+        do {
+            result = ::read(m_fd, &m_buffer[0], m_buffer.size());
+        } while (result < 0 && errno == EINTR);
+        if (result < 0) {
+            throw slightinput_read_error();
+        }
+        read_count = result;
+    }
+#endif
+    if (!read_count) {
+        return false;
+    }
+    t_data = &m_buffer[0];
+    t_size = read_count;
+    return true;
+}
+
+size_t utils::SlightStreamInput::getSize(void) const {
+    return 0;
+}
+
+void utils::SlightStreamInput::close(void) {
+    // the source is owned by the caller
+    m_file = 0;
+    m_fd = -1;
+    m_stream = 0;
+}
+
+void utils::SlightStreamInput::allocateBuffer(void) {
+    // (re)allocate read buffer only if its size changed
+    if (m_buffer.size() != m_buffer_size) {
+        vector<char>(m_buffer_size).swap(m_buffer);
+    }
+}
+
+utils::SlightMmapInput::SlightMmapInput(void) {
+    m_fd = -1;
+    m_size = 0;
+    m_offset = 0;
+    m_window_size = DEFAULT_WINDOW_SIZE;
+    m_window = 0;
+    m_window_length = 0;
+}
+
+utils::SlightMmapInput::~SlightMmapInput(void) {
+    this->close();
+}
+
+void utils::SlightMmapInput::setWindowSize(const size_t t_window_size) {
+    if (!t_window_size) {
+        throw slightinput_parameter_error();
+    }
+    m_window_size = t_window_size;
+}
+
+size_t utils::SlightMmapInput::getWindowSize(void) const {
+    return m_window_size;
+}
+
+#ifndef _WIN32
+
+void utils::SlightMmapInput::open(const string &t_filename) {
+    this->close();
+
+    m_fd = ::open(t_filename.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw slightinput_open_error();
+    }
+
+    // get file size from the file system (no seeking needed)
+    struct stat file_stat;
+    if (fstat(m_fd, &file_stat) != 0) {
+        this->close();
+        throw slightinput_open_error();
+    }
+    m_size = file_stat.st_size;
+    m_offset = 0;
+
+    // mapping offsets must be aligned to page boundaries, round window size up to a multiple of the page size
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    m_window_size = (m_window_size + page_size - 1) / page_size * page_size;
+}
+
+bool utils::SlightMmapInput::read(const char *&t_data, size_t &t_size) {
+    // release previous window before mapping the next one (address space usage stays bounded)
+    this->unmapWindow();
+
+    if (m_fd < 0 || m_offset >= m_size) {
+        return false;
+    }
+
+    // map next window (the last one may be shorter)
+    m_window_length = m_size - m_offset < m_window_size ? m_size - m_offset : m_window_size;
+    m_window = mmap(0, m_window_length, PROT_READ, MAP_PRIVATE, m_fd, m_offset);
+    if (m_window == MAP_FAILED) {
+        m_window = 0;
+        m_window_length = 0;
+        throw slightinput_read_error();
+    }
+    // the window is consumed front to back, let the kernel read ahead aggressively
+    madvise(m_window, m_window_length, MADV_SEQUENTIAL);
+
+    t_data = static_cast<const char*>(m_window);
+    t_size = m_window_length;
+    m_offset += m_window_length;
+
+    return true;
+}
+
+void utils::SlightMmapInput::close(void) {
+    this->unmapWindow();
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_fd = -1;
+    m_size = 0;
+    m_offset = 0;
+}
+
+void utils::SlightMmapInput::unmapWindow(void) {
+    if (m_window) {
+        munmap(m_window, m_window_length);
+    }
+    m_window = 0;
+    m_window_length = 0;
+}
+
+#else // _WIN32
+
+// memory mapping is not implemented on Windows, SlightCSV falls back to stream reading there
+
+void utils::SlightMmapInput::open(const string &t_filename) {
+    throw slightinput_open_error();
+}
+
+bool utils::SlightMmapInput::read(const char *&t_data, size_t &t_size) {
+    return false;
+}
+
+void utils::SlightMmapInput::close(void) {
+}
+
+void utils::SlightMmapInput::unmapWindow(void) {
+}
+
+#endif // _WIN32
+
+size_t utils::SlightMmapInput::getSize(void) const {
+    return m_size;
+}
+
+utils::SlightReadAheadInput::SlightReadAheadInput(void) {
+    m_source = 0;
+    m_size = 0;
+    m_buffer_count = DEFAULT_BUFFER_COUNT;
+    m_thread_running = false;
+    m_stall_time = 0;
+    pthread_mutex_init(&m_mutex, 0);
+    pthread_cond_init(&m_filled_cond, 0);
+    pthread_cond_init(&m_free_cond, 0);
+}
+
+utils::SlightReadAheadInput::~SlightReadAheadInput(void) {
+    this->close();
+    pthread_cond_destroy(&m_free_cond);
+    pthread_cond_destroy(&m_filled_cond);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+void utils::SlightReadAheadInput::setBufferCount(const size_t t_buffer_count) {
+    if (t_buffer_count < 2) {
+        throw slightinput_parameter_error();
+    }
+    m_buffer_count = t_buffer_count;
+}
+
+size_t utils::SlightReadAheadInput::getBufferCount(void) const {
+    return m_buffer_count;
+}
+
+void utils::SlightReadAheadInput::open(SlightInput &t_source) {
+    this->close();
+
+    m_source = &t_source;
+    m_size = t_source.getSize();
+    m_buffers.resize(m_buffer_count);
+    m_lengths.assign(m_buffer_count, 0);
+    m_read_index = 0;
+    m_write_index = 0;
+    m_filled_count = 0;
+    m_holding = false;
+    m_eof = false;
+    m_error = false;
+    m_stop = false;
+    m_stall_time = 0;
+
+    if (pthread_create(&m_thread, 0, &SlightReadAheadInput::run, this) != 0) {
+        m_source = 0;
+        throw slightinput_open_error();
+    }
+    m_thread_running = true;
+}
+
+bool utils::SlightReadAheadInput::read(const char *&t_data, size_t &t_size) {
+    if (!m_thread_running) {
+        return false;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+
+    // hand the buffer returned previously back to the I/O thread
+    if (m_holding) {
+        m_read_index = (m_read_index + 1) % m_buffer_count;
+        --m_filled_count;
+        m_holding = false;
+        pthread_cond_signal(&m_free_cond);
+    }
+
+    // wait for the next buffer to be filled (parser stall)
+    if (!m_filled_count && !m_eof && !m_error) {
+        double wait_start = getTime();
+        while (!m_filled_count && !m_eof && !m_error) {
+            pthread_cond_wait(&m_filled_cond, &m_mutex);
+        }
+        m_stall_time += getTime() - wait_start;
+    }
+
+    // buffers filled before the end of input (or a read error) are consumed first
+    if (!m_filled_count) {
+        bool error = m_error;
+        pthread_mutex_unlock(&m_mutex);
+        if (error) {
+            throw slightinput_read_error();
+        }
+        return false;
+    }
+
+    t_data = &m_buffers[m_read_index][0];
+    t_size = m_lengths[m_read_index];
+    m_holding = true;
+
+    pthread_mutex_unlock(&m_mutex);
+
+    return true;
+}
+
+size_t utils::SlightReadAheadInput::getSize(void) const {
+    return m_size;
+}
+
+void utils::SlightReadAheadInput::close(void) {
+    // stop and join I/O thread
+    if (m_thread_running) {
+        pthread_mutex_lock(&m_mutex);
+        m_stop = true;
+        pthread_cond_signal(&m_free_cond);
+        pthread_mutex_unlock(&m_mutex);
+        pthread_join(m_thread, 0);
+        m_thread_running = false;
+    }
+    if (m_source) {
+        m_source->close();
+    }
+    m_source = 0;
+    m_size = 0;
+}
+
+double utils::SlightReadAheadInput::getStallTime(void) const {
+    return m_stall_time;
+}
+
+void *utils::SlightReadAheadInput::run(void *t_self) {
+    static_cast<SlightReadAheadInput*>(t_self)->fill();
+    return 0;
+}
+
+void utils::SlightReadAheadInput::fill(void) {
+    while (true) {
+        // wait for a free buffer
+        pthread_mutex_lock(&m_mutex);
+        while (!m_stop && m_filled_count == m_buffer_count) {
+            pthread_cond_wait(&m_free_cond, &m_mutex);
+        }
+        if (m_stop) {
+            pthread_mutex_unlock(&m_mutex);
+            return;
+        }
+        size_t index = m_write_index;
+        pthread_mutex_unlock(&m_mutex);
+
+        // read next chunk of the source into the free buffer (the parser does not touch it until it is marked filled)
+        const char *chunk;
+        size_t chunk_size;
+        bool has_chunk = false;
+        bool error = false;
+        try {
+            has_chunk = m_source->read(chunk, chunk_size);
+            if (has_chunk) {
+                m_buffers[index].assign(chunk, chunk + chunk_size);
+                m_lengths[index] = chunk_size;
+            }
+        } catch (...) {
+            // exceptions cannot cross threads, report error to the reading side
+            error = true;
+        }
+
+        pthread_mutex_lock(&m_mutex);
+        if (error) {
+            m_error = true;
+        } else if (!has_chunk) {
+            m_eof = true;
+        } else {
+            m_write_index = (index + 1) % m_buffer_count;
+            ++m_filled_count;
+        }
+        pthread_cond_signal(&m_filled_cond);
+        pthread_mutex_unlock(&m_mutex);
+
+        if (error || !has_chunk) {
+            return;
+        }
+    }
+}
+
+#ifdef SLIGHTCSV_IO_URING
+
+namespace utils {
+
+    // io_uring instance with the mapped submission and completion queues, and the per slot read buffers
+    class SlightUringRing {
+
+        public:
+            int m_ring_fd;
+            void *m_sq_ptr;
+            size_t m_sq_ptr_size;
+            void *m_cq_ptr;
+            size_t m_cq_ptr_size;
+            io_uring_sqe *m_sqes;
+            size_t m_sqes_size;
+            unsigned *m_sq_tail;
+            unsigned *m_sq_mask;
+            unsigned *m_sq_array;
+            unsigned *m_cq_head;
+            unsigned *m_cq_tail;
+            unsigned *m_cq_mask;
+            io_uring_cqe *m_cqes;
+            // per slot data: buffer, file offset, requested and completed byte counts, pending state
+            vector< vector<char> > m_buffers;
+            vector<iovec> m_iovecs;
+            vector<size_t> m_offsets;
+            vector<size_t> m_lengths;
+            vector<size_t> m_done;
+            vector<bool> m_pending;
+            size_t m_pending_count;
+            bool m_error;
+
+    };
+
+} // utils
+
+using utils::SlightUringRing;
+
+static int uringSetup(const unsigned t_entries, io_uring_params *t_params) {
+    return syscall(__NR_io_uring_setup, t_entries, t_params);
+}
+
+static int uringEnter(const int t_ring_fd, const unsigned t_to_submit, const unsigned t_min_complete) {
+    return syscall(__NR_io_uring_enter, t_ring_fd, t_to_submit, t_min_complete, 
+        t_min_complete ? IORING_ENTER_GETEVENTS : 0, 0, _NSIG / 8);
+}
+
+static void uringRelease(SlightUringRing *t_ring) {
+    if (t_ring->m_sqes) {
+        munmap(t_ring->m_sqes, t_ring->m_sqes_size);
+    }
+    if (t_ring->m_cq_ptr && t_ring->m_cq_ptr != t_ring->m_sq_ptr) {
+        munmap(t_ring->m_cq_ptr, t_ring->m_cq_ptr_size);
+    }
+    if (t_ring->m_sq_ptr) {
+        munmap(t_ring->m_sq_ptr, t_ring->m_sq_ptr_size);
+    }
+    if (t_ring->m_ring_fd >= 0) {
+        ::close(t_ring->m_ring_fd);
+    }
+    delete t_ring;
+}
+
+static SlightUringRing *uringCreate(const unsigned t_entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int ring_fd = uringSetup(t_entries, &params);
+    if (ring_fd < 0) {
+        return 0;
+    }
+
+    SlightUringRing *ring = new SlightUringRing;
+    ring->m_ring_fd = ring_fd;
+    ring->m_sq_ptr = 0;
+    ring->m_cq_ptr = 0;
+    ring->m_sqes = 0;
+
+    // map submission and completion queue rings (a single mapping serves both on newer kernels)
+    ring->m_sq_ptr_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->m_cq_ptr_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->m_cq_ptr_size > ring->m_sq_ptr_size) {
+            ring->m_sq_ptr_size = ring->m_cq_ptr_size;
+        }
+        ring->m_cq_ptr_size = ring->m_sq_ptr_size;
+    }
+    void *sq_ptr = mmap(0, ring->m_sq_ptr_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, 
+        IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+        uringRelease(ring);
+        return 0;
+    }
+    ring->m_sq_ptr = sq_ptr;
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->m_cq_ptr = sq_ptr;
+    } else {
+        void *cq_ptr = mmap(0, ring->m_cq_ptr_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, 
+            IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED) {
+            uringRelease(ring);
+            return 0;
+        }
+        ring->m_cq_ptr = cq_ptr;
+    }
+    ring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(0, ring->m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, 
+        IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        uringRelease(ring);
+        return 0;
+    }
+    ring->m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char *sq = static_cast<char*>(ring->m_sq_ptr);
+    char *cq = static_cast<char*>(ring->m_cq_ptr);
+    ring->m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    ring->m_sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    ring->m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    ring->m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    ring->m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    ring->m_cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    ring->m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    ring->m_pending_count = 0;
+    ring->m_error = false;
+
+    return ring;
+}
+
+utils::SlightUringInput::SlightUringInput(void) {
+    m_ring = 0;
+    m_fd = -1;
+    m_size = 0;
+    m_buffer_size = DEFAULT_BUFFER_SIZE;
+    m_queue_depth = DEFAULT_BUFFER_COUNT;
+    m_holding = false;
+}
+
+bool utils::SlightUringInput::isAvailable(void) {
+    // io_uring may be compiled in, but disabled or filtered in the running kernel (e.g. in containers)
+    SlightUringRing *ring = uringCreate(1);
+    if (!ring) {
+        return false;
+    }
+    uringRelease(ring);
+    return true;
+}
+
+void utils::SlightUringInput::open(const string &t_filename) {
+    this->close();
+
+    m_fd = ::open(t_filename.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw slightinput_open_error();
+    }
+    struct stat file_stat;
+    if (fstat(m_fd, &file_stat) != 0) {
+        this->close();
+        throw slightinput_open_error();
+    }
+    m_size = file_stat.st_size;
+
+    // one slot more than the queue depth: the parser holds one block while the others are being read
+    size_t slot_count = m_queue_depth + 1;
+    m_ring = uringCreate(slot_count);
+    if (!m_ring) {
+        this->close();
+        throw slightinput_unsupported_error();
+    }
+    m_ring->m_buffers.resize(slot_count, vector<char>(m_buffer_size));
+    m_ring->m_iovecs.resize(slot_count);
+    m_ring->m_offsets.assign(slot_count, 0);
+    m_ring->m_lengths.assign(slot_count, 0);
+    m_ring->m_done.assign(slot_count, 0);
+    m_ring->m_pending.assign(slot_count, false);
+
+    m_submit_offset = 0;
+    m_read_offset = 0;
+    m_read_index = 0;
+    m_holding = false;
+
+    // fill the queue with reads of consecutive blocks
+    for (size_t i = 0; i < slot_count && m_submit_offset < m_size; ++i) {
+        this->submit(i);
+    }
+}
+
+bool utils::SlightUringInput::read(const char *&t_data, size_t &t_size) {
+    if (!m_ring) {
+        return false;
+    }
+
+    size_t slot_count = m_ring->m_buffers.size();
+
+    // the block returned previously is free again, reuse its slot for the next block
+    if (m_holding) {
+        m_holding = false;
+        if (m_submit_offset < m_size) {
+            this->submit(m_read_index);
+        }
+        m_read_index = (m_read_index + 1) % slot_count;
+    }
+
+    if (m_read_offset >= m_size) {
+        return false;
+    }
+
+    // blocks complete in any order, wait for the next one in file order
+    while (m_ring->m_pending[m_read_index]) {
+        this->complete();
+    }
+    if (m_ring->m_error) {
+        throw slightinput_read_error();
+    }
+
+    t_data = &m_ring->m_buffers[m_read_index][0];
+    t_size = m_ring->m_done[m_read_index];
+    m_read_offset += t_size;
+    m_holding = true;
+
+    // file truncated while reading
+    if (!t_size) {
+        m_read_offset = m_size;
+        return false;
+    }
+
+    return true;
+}
+
+void utils::SlightUringInput::close(void) {
+    if (m_ring) {
+        // buffers must not be released while the kernel may still write them (no exceptions are thrown here, as the
+        // destructor closes the input as well: if waiting fails, the ring is marked as failed and released)
+        while (m_ring->m_pending_count && !m_ring->m_error) {
+            try {
+                this->complete();
+            } catch (const slightinput_read_error &e) {
+                m_ring->m_error = true;
+            }
+        }
+        uringRelease(m_ring);
+    }
+    m_ring = 0;
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_fd = -1;
+    m_size = 0;
+    m_holding = false;
+}
+
+void utils::SlightUringInput::submit(const size_t t_slot) {
+    SlightUringRing &ring = *m_ring;
+
+    // start a new block if the slot is not pending (remainders of short reads are submitted for pending slots)
+    if (!ring.m_pending[t_slot]) {
+        ring.m_offsets[t_slot] = m_submit_offset;
+        ring.m_lengths[t_slot] = m_size - m_submit_offset < m_buffer_size ? m_size - m_submit_offset : m_buffer_size;
+        ring.m_done[t_slot] = 0;
+        ring.m_pending[t_slot] = true;
+        ++ring.m_pending_count;
+        m_submit_offset += ring.m_lengths[t_slot];
+    }
+
+    ring.m_iovecs[t_slot].iov_base = &ring.m_buffers[t_slot][ring.m_done[t_slot]];
+    ring.m_iovecs[t_slot].iov_len = ring.m_lengths[t_slot] - ring.m_done[t_slot];
+
+    // fill submission queue entry (vectored read is supported by all io_uring capable kernels)
+    unsigned tail = *ring.m_sq_tail;
+    unsigned index = tail & *ring.m_sq_mask;
+    io_uring_sqe *sqe = &ring.m_sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = m_fd;
+    sqe->addr = reinterpret_cast<unsigned long>(&ring.m_iovecs[t_slot]);
+    sqe->len = 1;
+    sqe->off = ring.m_offsets[t_slot] + ring.m_done[t_slot];
+    sqe->user_data = t_slot;
+    ring.m_sq_array[index] = index;
+    // publish entry to the kernel
+    __atomic_store_n(ring.m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    while (uringEnter(ring.m_ring_fd, 1, 0) < 0) {
+        if (errno != EINTR && errno != EAGAIN) {
+            ring.m_error = true;
+            throw slightinput_read_error();
+        }
+    }
+}
+
+void utils::SlightUringInput::complete(void) {
+    SlightUringRing &ring = *m_ring;
+
+    // wait for at least one completion
+    unsigned head = *ring.m_cq_head;
+    if (head == __atomic_load_n(ring.m_cq_tail, __ATOMIC_ACQUIRE)) {
+        if (uringEnter(ring.m_ring_fd, 0, 1) < 0 && errno != EINTR) {
+            ring.m_error = true;
+            throw slightinput_read_error();
+        }
+    }
+
+    // process all available completions
+    while (head != __atomic_load_n(ring.m_cq_tail, __ATOMIC_ACQUIRE)) {
+        io_uring_cqe *cqe = &ring.m_cqes[head & *ring.m_cq_mask];
+        size_t slot = cqe->user_data;
+        int res = cqe->res;
+        ++head;
+        __atomic_store_n(ring.m_cq_head, head, __ATOMIC_RELEASE);
+
+        if (res < 0 && res != -EINTR && res != -EAGAIN) {
+            ring.m_error = true;
+            ring.m_pending[slot] = false;
+            --ring.m_pending_count;
+            continue;
+        }
+        if (res > 0) {
+            ring.m_done[slot] += res;
+        }
+        // block complete or end of file reached (file truncated)
+        if (!res || ring.m_done[slot] == ring.m_lengths[slot]) {
+            ring.m_pending[slot] = false;
+            --ring.m_pending_count;
+        // short read, submit the remainder
+        } else {
+            this->submit(slot);
+        }
+    }
+}
+
+#else // SLIGHTCSV_IO_URING
+
+utils::SlightUringInput::SlightUringInput(void) {
+    m_ring = 0;
+    m_fd = -1;
+    m_size = 0;
+    m_buffer_size = DEFAULT_BUFFER_SIZE;
+    m_queue_depth = DEFAULT_BUFFER_COUNT;
+    m_holding = false;
+}
+
+bool utils::SlightUringInput::isAvailable(void) {
+    return false;
+}
+
+void utils::SlightUringInput::open(const string &t_filename) {
+    (void)t_filename;
+    throw slightinput_unsupported_error();
+}
+
+bool utils::SlightUringInput::read(const char *&t_data, size_t &t_size) {
+    (void)t_data;
+    (void)t_size;
+    return false;
+}
+
+void utils::SlightUringInput::close(void) {
+}
+
+void utils::SlightUringInput::submit(const size_t t_slot) {
+    (void)t_slot;
+}
+
+void utils::SlightUringInput::complete(void) {
+}
+
+#endif // SLIGHTCSV_IO_URING
+
+utils::SlightUringInput::~SlightUringInput(void) {
+    this->close();
+}
+
+void utils::SlightUringInput::setBufferSize(const size_t t_buffer_size) {
+    if (!t_buffer_size) {
+        throw slightinput_parameter_error();
+    }
+    m_buffer_size = t_buffer_size;
+}
+
+size_t utils::SlightUringInput::getBufferSize(void) const {
+    return m_buffer_size;
+}
+
+void utils::SlightUringInput::setQueueDepth(const size_t t_queue_depth) {
+    if (!t_queue_depth) {
+        throw slightinput_parameter_error();
+    }
+    m_queue_depth = t_queue_depth;
+}
+
+size_t utils::SlightUringInput::getQueueDepth(void) const {
+    return m_queue_depth;
+}
+
+size_t utils::SlightUringInput::getSize(void) const {
+    return m_size;
+}
+
+namespace utils {
+
+    // decompression stream state and the part of the current source chunk not consumed yet
+    class SlightDecompressStream {
+
+        public:
+#ifdef SLIGHTCSV_ZLIB
+            z_stream m_zstream;
+#endif
+#ifdef SLIGHTCSV_ZSTD
+            ZSTD_DStream *m_dstream;
+#endif
+            const char *m_in;
+            size_t m_in_size;
+            // the last gzip member or zstd frame is complete, the input may end here
+            bool m_frame_end;
+
+    };
+
+} // utils
+
+// decompress the next piece of the current source chunk into the buffer
+static size_t decompressGzip(utils::SlightDecompressStream &t_stream, vector<char> &t_buffer) {
+#ifdef SLIGHTCSV_ZLIB
+    z_stream &zs = t_stream.m_zstream;
+    if (t_stream.m_frame_end) {
+        if (!t_stream.m_in_size) {
+            return 0;
+        }
+        // concatenated gzip members form a single stream
+        inflateReset(&zs);
+        t_stream.m_frame_end = false;
+    }
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(t_stream.m_in));
+    zs.avail_in = t_stream.m_in_size;
+    zs.next_out = reinterpret_cast<Bytef*>(&t_buffer[0]);
+    zs.avail_out = t_buffer.size();
+    int ret = inflate(&zs, Z_NO_FLUSH);
+    if (ret == Z_STREAM_END) {
+        t_stream.m_frame_end = true;
+    } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        throw utils::slightinput_read_error();
+    }
+    t_stream.m_in += t_stream.m_in_size - zs.avail_in;
+    t_stream.m_in_size = zs.avail_in;
+    return t_buffer.size() - zs.avail_out;
+#else
+    (void)t_stream;
+    (void)t_buffer;
+    throw utils::slightinput_unsupported_error();
+#endif
+}
+
+static size_t decompressZstd(utils::SlightDecompressStream &t_stream, vector<char> &t_buffer) {
+#ifdef SLIGHTCSV_ZSTD
+    if (t_stream.m_frame_end && !t_stream.m_in_size) {
+        return 0;
+    }
+    // the decoder continues with the next frame on its own
+    ZSTD_inBuffer in = { t_stream.m_in, t_stream.m_in_size, 0 };
+    ZSTD_outBuffer out = { &t_buffer[0], t_buffer.size(), 0 };
+    size_t ret = ZSTD_decompressStream(t_stream.m_dstream, &out, &in);
+    if (ZSTD_isError(ret)) {
+        throw utils::slightinput_read_error();
+    }
+    t_stream.m_frame_end = !ret;
+    t_stream.m_in += in.pos;
+    t_stream.m_in_size -= in.pos;
+    return out.pos;
+#else
+    (void)t_stream;
+    (void)t_buffer;
+    throw utils::slightinput_unsupported_error();
+#endif
+}
+
+utils::SlightDecompressInput::SlightDecompressInput(void) {
+    m_stream = 0;
+    m_source = 0;
+    m_format = FORMAT_NONE;
+    m_size = 0;
+    m_buffer_size = DEFAULT_BUFFER_SIZE;
+    m_head_pending = false;
+    m_pending = 0;
+    m_pending_size = 0;
+    m_source_eof = false;
+}
+
+utils::SlightDecompressInput::~SlightDecompressInput(void) {
+    this->close();
+}
+
+bool utils::SlightDecompressInput::isSupported(const Format t_format) {
+    switch (t_format) {
+        case FORMAT_NONE:
+            return true;
+        case FORMAT_GZIP:
+#ifdef SLIGHTCSV_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case FORMAT_ZSTD:
+#ifdef SLIGHTCSV_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+utils::SlightDecompressInput::Format utils::SlightDecompressInput::detectFormat(const char *t_data, 
+    const size_t t_size) {
+    if (t_size >= sizeof(GZIP_MAGIC) && !memcmp(t_data, GZIP_MAGIC, sizeof(GZIP_MAGIC))) {
+        return FORMAT_GZIP;
+    }
+    if (t_size >= sizeof(ZSTD_MAGIC) && !memcmp(t_data, ZSTD_MAGIC, sizeof(ZSTD_MAGIC))) {
+        return FORMAT_ZSTD;
+    }
+    return FORMAT_NONE;
+}
+
+void utils::SlightDecompressInput::setBufferSize(const size_t t_buffer_size) {
+    if (!t_buffer_size) {
+        throw slightinput_parameter_error();
+    }
+    m_buffer_size = t_buffer_size;
+}
+
+size_t utils::SlightDecompressInput::getBufferSize(void) const {
+    return m_buffer_size;
+}
+
+void utils::SlightDecompressInput::open(SlightInput &t_source) {
+    this->close();
+
+    m_source = &t_source;
+    m_size = t_source.getSize();
+    m_source_eof = false;
+
+    // the magic bytes are examined in place, unless the first chunks are too short to hold them
+    const char *chunk = 0;
+    size_t chunk_size = 0;
+    if (t_source.read(chunk, chunk_size)) {
+        m_pending = chunk;
+        m_pending_size = chunk_size;
+    }
+    const char *magic = m_pending;
+    size_t magic_size = m_pending_size;
+    if (m_pending_size < MAGIC_SIZE) {
+        m_head.assign(m_pending, m_pending + m_pending_size);
+        m_pending_size = 0;
+        while (m_head.size() < MAGIC_SIZE && t_source.read(chunk, chunk_size)) {
+            size_t count = std::min(MAGIC_SIZE - m_head.size(), chunk_size);
+            m_head.insert(m_head.end(), chunk, chunk + count);
+            m_pending = chunk + count;
+            m_pending_size = chunk_size - count;
+        }
+        m_head_pending = true;
+        magic = m_head.size() ? &m_head[0] : 0;
+        magic_size = m_head.size();
+    }
+
+    m_format = detectFormat(magic, magic_size);
+    if (m_format == FORMAT_NONE) {
+        return;
+    }
+
+    m_stream = new SlightDecompressStream();
+    m_stream->m_in = 0;
+    m_stream->m_in_size = 0;
+    m_stream->m_frame_end = false;
+
+    if (m_format == FORMAT_GZIP) {
+#ifdef SLIGHTCSV_ZLIB
+        memset(&m_stream->m_zstream, 0, sizeof(m_stream->m_zstream));
+        // window bits 15 with gzip header decoding only
+        if (inflateInit2(&m_stream->m_zstream, 15 + 16) != Z_OK) {
+            delete m_stream;
+            m_stream = 0;
+            this->close();
+            throw slightinput_open_error();
+        }
+#else
+        delete m_stream;
+        m_stream = 0;
+        this->close();
+        throw slightinput_unsupported_error();
+#endif
+    } else {
+#ifdef SLIGHTCSV_ZSTD
+        m_stream->m_dstream = ZSTD_createDStream();
+        if (!m_stream->m_dstream || ZSTD_isError(ZSTD_initDStream(m_stream->m_dstream))) {
+            ZSTD_freeDStream(m_stream->m_dstream);
+            delete m_stream;
+            m_stream = 0;
+            this->close();
+            throw slightinput_open_error();
+        }
+        // the frame header may tell the decompressed size (for the parser's capacity estimate)
+        unsigned long long content_size = ZSTD_getFrameContentSize(magic, magic_size);
+        if (content_size != ZSTD_CONTENTSIZE_UNKNOWN && content_size != ZSTD_CONTENTSIZE_ERROR) {
+            m_size = content_size;
+        }
+#else
+        delete m_stream;
+        m_stream = 0;
+        this->close();
+        throw slightinput_unsupported_error();
+#endif
+    }
+
+    if (m_buffer.size() != m_buffer_size) {
+        vector<char>(m_buffer_size).swap(m_buffer);
+    }
+}
+
+utils::SlightDecompressInput::Format utils::SlightDecompressInput::getFormat(void) const {
+    return m_format;
+}
+
+bool utils::SlightDecompressInput::read(const char *&t_data, size_t &t_size) {
+    if (!m_source) {
+        return false;
+    }
+    if (m_format == FORMAT_NONE) {
+        return readSource(t_data, t_size);
+    }
+
+    while (true) {
+        if (!m_stream->m_in_size && !m_source_eof && !readSource(m_stream->m_in, m_stream->m_in_size)) {
+            m_stream->m_in_size = 0;
+            m_source_eof = true;
+        }
+        size_t produced;
+        if (m_format == FORMAT_GZIP) {
+            produced = decompressGzip(*m_stream, m_buffer);
+        } else {
+            produced = decompressZstd(*m_stream, m_buffer);
+        }
+        if (produced) {
+            t_data = &m_buffer[0];
+            t_size = produced;
+            return true;
+        }
+        if (m_source_eof && !m_stream->m_in_size) {
+            // the source must not end in the middle of a member or frame
+            if (!m_stream->m_frame_end) {
+                throw slightinput_read_error();
+            }
+            return false;
+        }
+    }
+}
+
+size_t utils::SlightDecompressInput::getSize(void) const {
+    return m_size;
+}
+
+void utils::SlightDecompressInput::close(void) {
+    if (m_stream) {
+#ifdef SLIGHTCSV_ZLIB
+        if (m_format == FORMAT_GZIP) {
+            inflateEnd(&m_stream->m_zstream);
+        }
+#endif
+#ifdef SLIGHTCSV_ZSTD
+        if (m_format == FORMAT_ZSTD) {
+            ZSTD_freeDStream(m_stream->m_dstream);
+        }
+#endif
+        delete m_stream;
+    }
+    m_stream = 0;
+    if (m_source) {
+        m_source->close();
+    }
+    m_source = 0;
+    m_format = FORMAT_NONE;
+    m_size = 0;
+    m_head.clear();
+    m_head_pending = false;
+    m_pending = 0;
+    m_pending_size = 0;
+}
+
+bool utils::SlightDecompressInput::readSource(const char *&t_data, size_t &t_size) {
+    // bytes consumed by format detection come first
+    if (m_head_pending) {
+        m_head_pending = false;
+        if (m_head.size()) {
+            t_data = &m_head[0];
+            t_size = m_head.size();
+            return true;
+        }
+    }
+    if (m_pending_size) {
+        t_data = m_pending;
+        t_size = m_pending_size;
+        m_pending_size = 0;
+        return true;
+    }
+    return m_source->read(t_data, t_size);
+}
@@ -0,0 +1,507 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef _UTILS_SLIGHTINPUT_HPP
+#define _UTILS_SLIGHTINPUT_HPP
+
+#include <string>
+#include <vector>
+#include <exception>
+#include <cstdio>
+#include <istream>
+#include <pthread.h>
+
+using std::string;
+using std::vector;
+using std::exception;
+
+namespace utils {
+
+    /// The input base class of the library. Input objects hand the bytes of the CSV source to the parser in
+    /// consecutive chunks. Chunk boundaries are arbitrary (they may split rows and UTF-8 characters as well), the
+    /// parser keeps its state between chunks.
+    class SlightInput {
+
+        public:
+            /// Virtual destructor of the class.
+            virtual ~SlightInput(void);
+
+            /// Method to get the next chunk of input bytes. The returned chunk stays valid until the next call of
+            /// the method or until the input is closed.
+            /// \param t_data pointer set to the first byte of the chunk.
+            /// \param t_size variable set to the number of bytes in the chunk.
+            /// \return false if there are no more bytes to read (end of input), true otherwise.
+            virtual bool read(const char *&t_data, size_t &t_size) = 0;
+
+            /// Method to get the total size of the input in bytes.
+            /// \return size of the input in bytes.
+            virtual size_t getSize(void) const = 0;
+
+            /// Method to close the input and release the resources held by it. Optional, inputs are closed on
+            /// destruction as well.
+            virtual void close(void) = 0;
+
+    };
+
+    /// Memory buffer input. The caller owned buffer is handed to the parser as a single chunk, without copying. The
+    /// buffer must stay valid (and unchanged) while the input is being read.
+    class SlightMemoryInput: public SlightInput {
+
+        public:
+            /// Default constructor of the class.
+            SlightMemoryInput(void);
+
+            /// Method to set the buffer to be read. A previously set buffer is released (not freed) first.
+            /// \param t_data pointer to the first byte of the buffer.
+            /// \param t_size number of bytes in the buffer.
+            void open(const char *t_data, const size_t t_size);
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            size_t getSize(void) const;
+
+            void close(void);
+
+        private:
+            const char *m_data;
+            size_t m_size;
+            bool m_read_done;
+
+    };
+
+    /// Buffered file input. The file is read in large blocks into a reusable buffer of a given size, the chunks 
+    /// returned point into this buffer.
+    class SlightFileInput: public SlightInput {
+
+        public:
+            /// Default constructor of the class.
+            SlightFileInput(void);
+
+            /// Destructor of the class. Closes the file.
+            ~SlightFileInput(void);
+
+            /// Method to set the size of the read buffer (the maximum number of bytes read at once). Changing the 
+            /// buffer size of an open input has no effect until the next open.
+            /// \param t_buffer_size size of the read buffer in bytes.
+            /// \see getBufferSize()
+            void setBufferSize(const size_t t_buffer_size);
+
+            /// Method to get the previously set size of the read buffer.
+            /// \return size of the read buffer in bytes.
+            /// \see setBufferSize()
+            size_t getBufferSize(void) const;
+
+            /// Method to open the file to be read. A previously opened file is closed first.
+            /// \param t_filename name and relative path of the file.
+            void open(const string &t_filename);
+
+            /// Method to move the read position of the open file, reading continues from the given byte offset.
+            /// \param t_offset byte offset from the beginning of the file (not more than the file size).
+            void seek(const size_t t_offset);
+
+            /// Method to get an identifier of the open file (the inode number on POSIX systems, zero elsewhere). A
+            /// file replaced under the same name (e.g. by log rotation) gets a different identifier.
+            /// \return identifier of the file.
+            unsigned long getFileId(void) const;
+
+            /// Method to check if the open file supports seeking (false for pipes, FIFOs, terminals, etc.). The size 
+            /// of non-seekable files is reported as zero.
+            /// \return true if the open file is seekable, false otherwise.
+            bool getIsSeekable(void) const;
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            size_t getSize(void) const;
+
+            void close(void);
+
+        private:
+            FILE *m_file;
+            size_t m_size;
+            bool m_is_seekable;
+            size_t m_buffer_size;
+            vector<char> m_buffer;
+
+    };
+
+    /// Non-seekable stream input (stdin, pipes, FIFOs, sockets). A caller owned stdio stream, file descriptor or 
+    /// standard input stream is read sequentially into a reusable buffer of a given size, the chunks returned point 
+    /// into this buffer. The size of the input is not known in advance, it is reported as zero. The source is not
+    /// closed by the input.
+    class SlightStreamInput: public SlightInput {
+
+        public:
+            /// Default constructor of the class.
+            SlightStreamInput(void);
+
+            /// Method to set the size of the read buffer (the maximum number of bytes read at once). Changing the 
+            /// buffer size of an open input has no effect until the next open.
+            /// \param t_buffer_size size of the read buffer in bytes.
+            /// \see getBufferSize()
+            void setBufferSize(const size_t t_buffer_size);
+
+            /// Method to get the previously set size of the read buffer.
+            /// \return size of the read buffer in bytes.
+            /// \see setBufferSize()
+            size_t getBufferSize(void) const;
+
+            /// Method to set the stdio stream to be read (e.g. stdin or the result of popen()).
+            /// \param t_file stdio stream opened for reading.
+            void open(FILE *t_file);
+
+            /// \overload
+            /// Method to set the file descriptor to be read (e.g. 0 for the standard input or a pipe).
+            /// \param t_fd file descriptor opened for reading.
+            void open(const int t_fd);
+
+            /// \overload
+            /// Method to set the standard input stream to be read (e.g. std::cin).
+            /// \param t_stream input stream.
+            void open(std::istream &t_stream);
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            size_t getSize(void) const;
+
+            void close(void);
+
+        private:
+            void allocateBuffer(void);
+
+            FILE *m_file;
+            int m_fd;
+            std::istream *m_stream;
+            size_t m_buffer_size;
+            vector<char> m_buffer;
+
+    };
+
+    /// Memory mapped file input. The file is mapped into memory in sliding windows of a given size and the chunks
+    /// returned point directly into the mapped region (no copying is involved). Windowing keeps the address space
+    /// usage bounded even if the file is larger than the available (virtual) memory.
+    class SlightMmapInput: public SlightInput {
+
+        public:
+            /// Default constructor of the class.
+            SlightMmapInput(void);
+
+            /// Destructor of the class. Unmaps the current window and closes the file.
+            ~SlightMmapInput(void);
+
+            /// Method to set the size of the mapping window. The value is rounded up to a multiple of the system page
+            /// size. Changing the window size of an open input has no effect until the next open.
+            /// \param t_window_size size of the mapping window in bytes.
+            /// \see getWindowSize()
+            void setWindowSize(const size_t t_window_size);
+
+            /// Method to get the previously set size of the mapping window.
+            /// \return size of the mapping window in bytes.
+            /// \see setWindowSize()
+            size_t getWindowSize(void) const;
+
+            /// Method to open the file to be mapped. A previously opened file is closed first.
+            /// \param t_filename name and relative path of the file.
+            void open(const string &t_filename);
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            size_t getSize(void) const;
+
+            void close(void);
+
+        private:
+            void unmapWindow(void);
+
+            int m_fd;
+            size_t m_size;
+            size_t m_offset;
+            size_t m_window_size;
+            void *m_window;
+            size_t m_window_length;
+
+    };
+
+    /// Read-ahead input. Reads another input on a dedicated I/O thread into a ring of buffers, while the parser 
+    /// consumes the buffers already filled (double buffering with the default buffer count of 2). Reading and parsing
+    /// overlap this way. The time the parser spent waiting for data is measured, so it can be told whether loading 
+    /// was I/O or CPU bound.
+    class SlightReadAheadInput: public SlightInput {
+
+        public:
+            /// Default constructor of the class.
+            SlightReadAheadInput(void);
+
+            /// Destructor of the class. Stops the I/O thread and closes the source input.
+            ~SlightReadAheadInput(void);
+
+            /// Method to set the number of buffers in the ring (at least 2). One buffer is held by the parser, the
+            /// rest may be filled in advance. Changing the buffer count of an open input has no effect until the
+            /// next open.
+            /// \param t_buffer_count number of buffers.
+            /// \see getBufferCount()
+            void setBufferCount(const size_t t_buffer_count);
+
+            /// Method to get the previously set number of buffers in the ring.
+            /// \return number of buffers.
+            /// \see setBufferCount()
+            size_t getBufferCount(void) const;
+
+            /// Method to start reading the source input on the I/O thread. The source input must be open and must 
+            /// outlive this object (it is closed, but not destroyed, by close()). A previously opened input is closed 
+            /// first.
+            /// \param t_source input to read ahead.
+            void open(SlightInput &t_source);
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            size_t getSize(void) const;
+
+            void close(void);
+
+            /// Method to get the time read() spent waiting for the I/O thread to fill a buffer since opening the 
+            /// input.
+            /// \return waiting time in seconds.
+            double getStallTime(void) const;
+
+        private:
+            static void *run(void *t_self);
+            void fill(void);
+
+            SlightInput *m_source;
+            size_t m_size;
+            size_t m_buffer_count;
+            vector< vector<char> > m_buffers;
+            vector<size_t> m_lengths;
+            size_t m_read_index;
+            size_t m_write_index;
+            size_t m_filled_count;
+            bool m_holding;
+            bool m_eof;
+            bool m_error;
+            bool m_stop;
+            bool m_thread_running;
+            pthread_t m_thread;
+            pthread_mutex_t m_mutex;
+            pthread_cond_t m_filled_cond;
+            pthread_cond_t m_free_cond;
+            double m_stall_time;
+
+    };
+
+    /// A forward declared class to hold the io_uring instance of SlightUringInput (pImpl).
+    class SlightUringRing;
+
+    /// io_uring based file input (Linux only). Keeps several large reads of consecutive file blocks in flight at 
+    /// the same time (the queue depth) and returns the completed blocks in file order. Deep queues are needed to 
+    /// saturate fast (NVMe) devices, which a single synchronous reader never does.
+    class SlightUringInput: public SlightInput {
+
+        public:
+            /// Default constructor of the class.
+            SlightUringInput(void);
+
+            /// Destructor of the class. Waits for reads in flight, releases the ring and closes the file.
+            ~SlightUringInput(void);
+
+            /// Method to check whether io_uring can be used (the library is built with io_uring support and the 
+            /// running kernel allows setting up a ring).
+            /// \return true if io_uring is available.
+            static bool isAvailable(void);
+
+            /// Method to set the size of a single read (block size). Changing the buffer size of an open input has 
+            /// no effect until the next open.
+            /// \param t_buffer_size size of a read in bytes.
+            /// \see getBufferSize()
+            void setBufferSize(const size_t t_buffer_size);
+
+            /// Method to get the previously set size of a single read.
+            /// \return size of a read in bytes.
+            /// \see setBufferSize()
+            size_t getBufferSize(void) const;
+
+            /// Method to set the number of reads kept in flight while the parser processes a block. Changing the 
+            /// queue depth of an open input has no effect until the next open.
+            /// \param t_queue_depth number of reads in flight.
+            /// \see getQueueDepth()
+            void setQueueDepth(const size_t t_queue_depth);
+
+            /// Method to get the previously set number of reads kept in flight.
+            /// \return number of reads in flight.
+            /// \see setQueueDepth()
+            size_t getQueueDepth(void) const;
+
+            /// Method to open the file to be read and to submit the first reads. A previously opened file is closed 
+            /// first. If io_uring is not available, slightinput_unsupported_error is thrown (callers may fall back
+            /// to another input).
+            /// \param t_filename name and relative path of the file.
+            void open(const string &t_filename);
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            size_t getSize(void) const;
+
+            void close(void);
+
+        private:
+            SlightUringInput(const SlightUringInput &);
+            SlightUringInput &operator=(const SlightUringInput &);
+
+            void submit(const size_t t_slot);
+            void complete(void);
+
+            SlightUringRing *m_ring;
+            int m_fd;
+            size_t m_size;
+            size_t m_buffer_size;
+            size_t m_queue_depth;
+            size_t m_submit_offset;
+            size_t m_read_offset;
+            size_t m_read_index;
+            bool m_holding;
+
+    };
+
+    /// A forward declared class to hold the decompression stream of SlightDecompressInput (pImpl).
+    class SlightDecompressStream;
+
+    /// Decompressing input. Detects gzip and zstd compressed sources by their magic bytes and decompresses them
+    /// on the fly, in chunks of a given size, so the whole decompressed content is never held in memory. Sources
+    /// that are not compressed are passed through without copying.
+    class SlightDecompressInput: public SlightInput {
+
+        public:
+            /// Compression formats of the source input.
+            enum Format {
+                FORMAT_NONE,
+                FORMAT_GZIP,
+                FORMAT_ZSTD
+            };
+
+            /// Default constructor of the class.
+            SlightDecompressInput(void);
+
+            /// Destructor of the class. Releases the decompression stream and closes the source input.
+            ~SlightDecompressInput(void);
+
+            /// Method to check whether a compression format can be decompressed (the library is built with support
+            /// for it).
+            /// \param t_format compression format to check.
+            /// \return true if the format is supported.
+            static bool isSupported(const Format t_format);
+
+            /// Method to detect the compression format of data by its leading (magic) bytes.
+            /// \param t_data pointer to the first byte of the data.
+            /// \param t_size number of bytes available (at least 4 are needed to recognize all formats).
+            /// \return compression format of the data.
+            static Format detectFormat(const char *t_data, const size_t t_size);
+
+            /// Method to set the size of the decompressed chunks. Changing the buffer size of an open input has no
+            /// effect until the next open.
+            /// \param t_buffer_size size of a decompressed chunk in bytes.
+            /// \see getBufferSize()
+            void setBufferSize(const size_t t_buffer_size);
+
+            /// Method to get the previously set size of the decompressed chunks.
+            /// \return size of a decompressed chunk in bytes.
+            /// \see setBufferSize()
+            size_t getBufferSize(void) const;
+
+            /// Method to detect the compression format of the source input. The source input must be open and must
+            /// outlive this object (it is closed, but not destroyed, by close()). A previously opened input is closed
+            /// first. If the detected format is not supported by the build, slightinput_unsupported_error is thrown.
+            /// \param t_source input to decompress.
+            void open(SlightInput &t_source);
+
+            /// Method to get the compression format detected on open.
+            /// \return compression format of the source input.
+            Format getFormat(void) const;
+
+            bool read(const char *&t_data, size_t &t_size);
+
+            /// Method to get the size of the input. For compressed sources it is the decompressed size if the format
+            /// stores it (zstd frames may do so), the compressed size otherwise.
+            /// \return size of the input in bytes.
+            size_t getSize(void) const;
+
+            void close(void);
+
+        private:
+            SlightDecompressInput(const SlightDecompressInput &);
+            SlightDecompressInput &operator=(const SlightDecompressInput &);
+
+            bool readSource(const char *&t_data, size_t &t_size);
+
+            SlightDecompressStream *m_stream;
+            SlightInput *m_source;
+            Format m_format;
+            size_t m_size;
+            size_t m_buffer_size;
+            vector<char> m_buffer;
+            // bytes read by format detection, handed out before the rest of the source
+            vector<char> m_head;
+            bool m_head_pending;
+            const char *m_pending;
+            size_t m_pending_size;
+            bool m_source_eof;
+
+    };
+
+    /// Base exception of the class (never gets thrown). Inheriting from std::exception.
+    class slightinput_error: public exception {};
+
+    /// Exception inheriting from slightinput_error. It is thrown when:
+    /// - input cannot be opened (file not found or not accessible, null buffer)
+    class slightinput_open_error: public slightinput_error {
+
+        const char* what() const throw() {
+            return "Input cannot be opened.";
+        }
+
+    };
+
+    /// Exception inheriting from slightinput_error. It is thrown when:
+    /// - method is called with zero or empty parameter
+    class slightinput_parameter_error: public slightinput_error {
+
+        const char* what() const throw() {
+            return "Invalid parameter.";
+        }
+
+    };
+
+    /// Exception inheriting from slightinput_error. It is thrown when:
+    /// - the input type is not supported by the platform or the running kernel
+    class slightinput_unsupported_error: public slightinput_error {
+
+        const char* what() const throw() {
+            return "Input type not supported.";
+        }
+
+    };
+
+    /// Exception inheriting from slightinput_error. It is thrown when:
+    /// - reading or mapping the input fails before reaching the end of the input
+    class slightinput_read_error: public slightinput_error {
+
+        const char* what() const throw() {
+            return "Unexpected error occurred while reading input.";
+        }
+
+    };
+
+} // utils
+
+#endif // _UTILS_SLIGHTINPUT_HPP
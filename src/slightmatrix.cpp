@@ -24,7 +24,12 @@ using std::atoi;
 template <class T>
 void convertCell(const string &cell_str, T &cell_value);
 
+// capacity (in cells) of an empty data store growing without an estimate
+static const size_t MIN_GROWTH_CAPACITY = 1024;
+
 utils::SlightMatrix::SlightMatrix(void) {
+    m_growth_factor = 2;
+    m_null_policy = NULL_POLICY_VALUE;
     reset();
 }
 
@@ -32,7 +37,18 @@ void utils::SlightMatrix::setCapacity(const size_t t_cell_count) {
     if (!t_cell_count) {
         throw slightmatrix_parameter_error();
     }
-    m_data.reserve(t_cell_count);
+    reserveCells(t_cell_count, false);
+}
+
+void utils::SlightMatrix::setGrowthFactor(const double t_growth_factor) {
+    if (!(t_growth_factor > 1)) {
+        throw slightmatrix_parameter_error();
+    }
+    m_growth_factor = t_growth_factor;
+}
+
+double utils::SlightMatrix::getGrowthFactor(void) const {
+    return m_growth_factor;
 }
 
 size_t utils::SlightMatrix::getCapacity(void) const {
@@ -48,17 +64,102 @@ size_t utils::SlightMatrix::getColumnCount(void) const {
 }
 
 void utils::SlightMatrix::addCell(const string t_cell) {
+    reserveCells(m_data.size() + 1, true);
     m_data.push_back(t_cell);
     // after adding cell, re-calculate row count
     updateRowCount();
 }
 
 void utils::SlightMatrix::addCells(const vector<string> &t_cells) {
+    reserveCells(m_data.size() + t_cells.size(), true);
     m_data.insert(m_data.end(), t_cells.begin(), t_cells.end());
     // after adding cells, re-calculate row count
     updateRowCount();
 }
 
+void utils::SlightMatrix::removeRows(const size_t t_row_count) {
+    if (t_row_count > m_row_count) {
+        throw slightmatrix_row_error();
+    }
+    if (!t_row_count) {
+        return;
+    }
+    // the last row may be partially filled
+    m_data.resize((m_row_count - t_row_count) * m_column_count);
+    updateRowCount();
+    if (m_header_count > m_row_count) {
+        m_header_count = m_row_count;
+    }
+}
+
+void utils::SlightMatrix::removeRows(const size_t t_row_index, const size_t t_row_count) {
+    if (t_row_index > m_row_count || t_row_count > m_row_count - t_row_index) {
+        throw slightmatrix_row_error();
+    }
+    if (!t_row_count) {
+        return;
+    }
+    // swap the cells of the following rows into place, the last row may be partially filled
+    size_t first_cell = t_row_index * m_column_count;
+    size_t end_cell = std::min(m_data.size(), first_cell + t_row_count * m_column_count);
+    for (size_t i = end_cell; i < m_data.size(); ++i) {
+        m_data[first_cell + i - end_cell].swap(m_data[i]);
+    }
+    m_data.resize(first_cell + m_data.size() - end_cell);
+    updateRowCount();
+    if (m_header_count > t_row_index) {
+        m_header_count -= std::min(t_row_count, m_header_count - t_row_index);
+    }
+}
+
+void utils::SlightMatrix::setRowCount(const size_t t_row_count) {
+    if (!m_column_count) {
+        throw slightmatrix_column_error();
+    }
+    reserveCells(t_row_count * m_column_count, false);
+    m_data.resize(t_row_count * m_column_count);
+    updateRowCount();
+    if (m_header_count > m_row_count) {
+        m_header_count = m_row_count;
+    }
+}
+
+void utils::SlightMatrix::setRow(const size_t t_row_index, vector<string> &t_cells) {
+    if (!m_column_count || t_cells.size() != m_column_count) {
+        throw slightmatrix_column_error();
+    }
+    // the last row may be partially filled
+    if (t_row_index >= m_data.size() / m_column_count) {
+        throw slightmatrix_row_error();
+    }
+    string *row = &m_data[t_row_index * m_column_count];
+    for (size_t i = 0; i < m_column_count; ++i) {
+        row[i].swap(t_cells[i]);
+    }
+}
+
+void utils::SlightMatrix::appendRows(SlightMatrix &t_source, const size_t t_start_row_index) {
+    if (t_start_row_index > t_source.m_row_count) {
+        throw slightmatrix_row_error();
+    }
+    if (!m_column_count) {
+        m_column_count = t_source.m_column_count;
+    }
+    if (t_source.m_row_count && t_source.m_column_count != m_column_count) {
+        throw slightmatrix_column_error();
+    }
+    // swap cell contents instead of copying them
+    size_t start = m_data.size();
+    size_t first_cell = t_start_row_index * t_source.m_column_count;
+    reserveCells(start + t_source.m_data.size() - first_cell, true);
+    m_data.resize(start + t_source.m_data.size() - first_cell);
+    for (size_t i = first_cell; i < t_source.m_data.size(); ++i) {
+        m_data[start + i - first_cell].swap(t_source.m_data[i]);
+    }
+    updateRowCount();
+    t_source.reset();
+}
+
 void utils::SlightMatrix::setHeaderCount(const size_t t_header_count) {
     m_header_count = t_header_count;
 }
@@ -81,6 +182,35 @@ size_t utils::SlightMatrix::getRowCount(void) const {
     return m_row_count;
 }
 
+void utils::SlightMatrix::setNullPolicy(const NullPolicy t_policy) {
+    m_null_policy = t_policy;
+}
+
+utils::SlightMatrix::NullPolicy utils::SlightMatrix::getNullPolicy(void) const {
+    return m_null_policy;
+}
+
+void utils::SlightMatrix::setNullValue(const string &t_value) {
+    m_null_value = t_value;
+}
+
+string utils::SlightMatrix::getNullValue(void) const {
+    return m_null_value;
+}
+
+bool utils::SlightMatrix::isNull(const size_t t_row_index, const size_t t_column_index) const {
+    if (!validate()) {
+        throw slightmatrix_matrix_error();
+    }
+    if (t_row_index >= m_row_count) {
+        throw slightmatrix_row_error();
+    }
+    if (t_column_index >= m_column_count) {
+        throw slightmatrix_column_error();
+    }
+    return m_data[t_row_index * m_column_count + t_column_index].empty();
+}
+
 template <class T>
 void utils::SlightMatrix::getCell(T &t_value, const size_t t_row_index, const size_t t_column_index) const {
     if (!validate()) {
@@ -92,7 +222,15 @@ void utils::SlightMatrix::getCell(T &t_value, const size_t t_row_index, const si
     if (t_column_index >= m_column_count) {
         throw slightmatrix_column_error();
     }
-    string cell = m_data.at(t_row_index * m_column_count + t_column_index);
+    const string &cell = m_data[t_row_index * m_column_count + t_column_index];
+    // null cells have no contents to convert
+    if (cell.empty()) {
+        if (m_null_policy == NULL_POLICY_THROW) {
+            throw slightmatrix_null_error();
+        }
+        convertCell(m_null_value, t_value);
+        return;
+    }
     convertCell(cell, t_value);
 }
 
@@ -240,6 +378,26 @@ void utils::SlightMatrix::reset(void) {
     vector<string>().swap(m_data);
 }
 
+void utils::SlightMatrix::reserveCells(const size_t t_cell_count, const bool t_grow) {
+    if (t_cell_count <= m_data.capacity()) {
+        return;
+    }
+    size_t capacity = t_cell_count;
+    // when growing, the capacity is multiplied, so adding cells one row at a time takes amortized constant time
+    if (t_grow) {
+        capacity = std::max(capacity, (size_t)(m_data.capacity() * m_growth_factor));
+        capacity = std::max(capacity, MIN_GROWTH_CAPACITY);
+    }
+    // a plain reserve would copy every cell string to the new storage (no move semantics), swap them instead
+    vector<string> data;
+    data.reserve(capacity);
+    data.resize(m_data.size());
+    for (size_t i = 0; i < m_data.size(); ++i) {
+        data[i].swap(m_data[i]);
+    }
+    m_data.swap(data);
+}
+
 void utils::SlightMatrix::updateRowCount(void) {
     if (!m_column_count) {
         return;
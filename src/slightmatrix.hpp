@@ -28,10 +28,20 @@ using std::exception;
 namespace utils {
 
     /// The data storege class of the library. It is storing data in a single vector and mapping cells, rows and columns
-    /// based on matrix format data.
+    /// based on matrix format data. Cells without contents (empty strings, no memory allocated for them) are null 
+    /// cells, e.g. empty fields of the input.
     class SlightMatrix {
 
         public:
+            /// Handling of null cells by the typed data query methods (getCell(), getColumn()).
+            enum NullPolicy {
+                /// Null cells are converted from the null value (see setNullValue(), empty by default: zero for 
+                /// numeric types and an empty string).
+                NULL_POLICY_VALUE,
+                /// Querying a null cell throws an exception.
+                NULL_POLICY_THROW
+            };
+
             /// The class's default constructor.
             SlightMatrix(void);
 
@@ -41,6 +51,19 @@ namespace utils {
             /// \see getCapacity()
             void setCapacity(const size_t t_cell_count);
 
+            /// Method to set the factor the capacity is multiplied by when cells are added to a full data store (e.g.
+            /// when the size of the input is not known in advance). Cell contents are moved (not copied) to the
+            /// larger storage. A larger factor means less reallocations, a smaller one less unused memory.
+            /// \param t_growth_factor growth factor of the capacity (more than 1).
+            /// \see getGrowthFactor()
+            /// \see setCapacity()
+            void setGrowthFactor(const double t_growth_factor);
+
+            /// Method to get the previously set growth factor of the capacity.
+            /// \return growth factor of the capacity (default is 2).
+            /// \see setGrowthFactor()
+            double getGrowthFactor(void) const;
+
             /// Method to query the amount of cells memory is reserved for in the data matrix.
             /// \return number of cells memory is reserved for.
             /// \see setCapacity()
@@ -72,6 +95,43 @@ namespace utils {
             /// \see getCell()
             void addCells(const vector<string> &t_cells);
 
+            /// Method to remove rows from the end of the data matrix. Header rows removed are not counted as header 
+            /// rows any more.
+            /// \param t_row_count number of rows to remove.
+            /// \see addCells()
+            void removeRows(const size_t t_row_count);
+
+            /// Method to remove rows from the data matrix at a given position. The rows after them are moved up (cells
+            /// are moved, not copied). Header rows removed are not counted as header rows any more.
+            /// \param t_row_index index (starting from 0) of the first row to remove.
+            /// \param t_row_count number of rows to remove.
+            /// \overload
+            void removeRows(const size_t t_row_index, const size_t t_row_count);
+
+            /// Method to set the number of rows of the data matrix when it is known in advance (e.g. from an index of
+            /// the rows). Rows are added with empty cells, to be filled by setRow(), or removed from the end. Memory is 
+            /// reserved for exactly the cells needed. The column count must be set.
+            /// \param t_row_count number of rows of the data matrix.
+            /// \see setRow()
+            /// \see getRowCount()
+            void setRowCount(const size_t t_row_count);
+
+            /// Method to set the cells of a row allocated before by setRowCount(). Cells are swapped (not copied), so
+            /// the vector gets the previous contents of the row. The memory of the matrix is not reallocated, 
+            /// different rows can be set on different threads at the same time.
+            /// \param t_row_index index (starting from 0) of the row to set.
+            /// \param t_cells contents of the cells of the row (as many as there are columns).
+            /// \see setRowCount()
+            void setRow(const size_t t_row_index, vector<string> &t_cells);
+
+            /// Method to move rows of another data matrix to the end of this one. Cells are moved (not copied) and the 
+            /// source matrix is reset. The column counts of the matrices must match (a matrix without column count 
+            /// set takes the column count of the source). Header rows moved are not counted as header rows.
+            /// \param t_source data matrix to move the rows from.
+            /// \param t_start_row_index index (starting from 0) of the first row to move (e.g. to leave out headers).
+            /// \see addCells()
+            void appendRows(SlightMatrix &t_source, const size_t t_start_row_index);
+
             /// Method to set the number of header rows the data matrix contains.
             /// \param t_header_count number of header rows the data matrix contains.
             /// \see getHeaderCount()
@@ -95,10 +155,43 @@ namespace utils {
             /// \see getColumnCount()
             size_t getRowCount(void) const;
 
+            /// Method to select how null cells are handled by the typed data query methods. The policy is kept by
+            /// reset().
+            /// \param t_policy policy to use (default is NULL_POLICY_VALUE).
+            /// \see getNullPolicy()
+            /// \see setNullValue()
+            void setNullPolicy(const NullPolicy t_policy);
+
+            /// Method to get the previously set null cell policy.
+            /// \return policy used by the typed data query methods.
+            /// \see setNullPolicy()
+            NullPolicy getNullPolicy(void) const;
+
+            /// Method to set the value null cells are converted from by the typed data query methods (e.g. "0" as
+            /// empty fields were stored by earlier versions, or "nan" for floating point columns). The value is kept
+            /// by reset().
+            /// \param t_value string value of null cells (default is empty).
+            /// \see getNullValue()
+            /// \see setNullPolicy()
+            void setNullValue(const string &t_value);
+
+            /// Method to get the previously set value of null cells.
+            /// \return string value of null cells.
+            /// \see setNullValue()
+            string getNullValue(void) const;
+
+            /// Method to check whether a specific cell is null (it has no contents).
+            /// \param t_row_index index (starting from 0) of the row of the cell.
+            /// \param t_column_index index (starting from 0) of the column of the cell.
+            /// \return true if the cell is null, false otherwise.
+            /// \see setNullPolicy()
+            bool isNull(const size_t t_row_index, const size_t t_column_index) const;
+
             /// Method to get the contents of a specific cell. The internal data structure stores cell values as strings.
             /// When using the method, the library tries to convert the string contents to the type supplied as the 
             /// first parameter of the method. Supported types: int, float, double, string. If conversion fails,
-            /// the value returned will be 0. In this case, it is always possible to get the value as string.
+            /// the value returned will be 0. In this case, it is always possible to get the value as string. Null 
+            /// cells are handled by the null policy (see setNullPolicy()).
             /// \param t_value variable to hold the value of the cell.
             /// \param t_row_index index (starting from 0) of the row the cell queried.
             /// \param t_column_index index (starting from 0) of the column holding the cell queried.
@@ -111,7 +204,7 @@ namespace utils {
 
             /// Method to get the cells of a specific row. The row is represented in the form of a vector.
             /// The internal data structure stores cell values as strings. When using the method, the library
-            /// returns cells in a row as strings.
+            /// returns cells in a row as strings (null cells as empty strings).
             /// \param t_target_row vector to hold the values of the cells in the row.
             /// \param t_row_index index (starting from 0) of the row to be returned.
             /// \see getColumn()
@@ -146,7 +239,8 @@ namespace utils {
             /// The internal data structure stores cell values as strings. When using the method, the library tries 
             /// to convert the string contents to the type held by the vector supplied as the method. Supported 
             /// types: int, float, double, string. If conversion fails, the value returned will be 0. In this case, 
-            /// it is always possible to get the value as string.
+            /// it is always possible to get the value as string. Null cells are handled by the null policy (see
+            /// setNullPolicy()).
             /// \param t_target_column vector to hold the values of the cells in the column.
             /// \param t_column_index index (starting from 0) of the column to be returned.
             /// \see getRow()
@@ -185,13 +279,19 @@ namespace utils {
             void getColumn(vector<T> &t_target_column, const size_t t_column_index, 
             const size_t t_start_cell_index, const size_t t_cell_count) const;
             
-            /// Method to reset data matrix to its initial state.
+            /// Method to reset data matrix to its initial state (the growth factor and the null cell settings are 
+            /// kept).
             void reset(void);
 
         private:
             void updateRowCount(void);
+
+            void reserveCells(const size_t t_cell_count, const bool t_grow);
             
             vector<string> m_data;
+            double m_growth_factor;
+            NullPolicy m_null_policy;
+            string m_null_value;
             size_t m_row_count;
             size_t m_column_count;
             size_t m_header_count;
@@ -234,6 +334,15 @@ namespace utils {
         }
     };
 
+    /// Exception inheriting from slightmatrix_error. It is thrown when:
+    /// - querying the value of a null cell with the throwing null policy.
+    /// \see setNullPolicy()
+    class slightmatrix_null_error: public slightmatrix_error {
+        const char* what() const throw() {
+            return "Null cell (no value).";
+        }
+    };
+
 } // utils
 
 #endif // _UTILS_SLIGHTMATRIX_HPP
\ No newline at end of file
@@ -43,6 +43,7 @@ void utils::SlightRow::setSeparator(const U8char t_sep) {
     // clear processing results related fields
     this->clearResults();
     m_sep = t_sep;
+    this->setupTables();
 }
 
 void utils::SlightRow::getSeparator(U8char &t_target) const {
@@ -60,6 +61,7 @@ void utils::SlightRow::setEscape(const U8char t_esc) {
     // clear processing results related fields
     this->clearResults();
     m_esc = t_esc;
+    this->setupTables();
 }
 
 void utils::SlightRow::getEscape(U8char &t_target) const {
@@ -70,6 +72,16 @@ void utils::SlightRow::getEscape(U8char &t_target) const {
     t_target = m_esc;
 }
 
+void utils::SlightRow::setEmptyCellZero(const bool t_is_zero) {
+    // clear processing results related fields
+    this->clearResults();
+    m_empty_cell = t_is_zero ? "0" : "";
+}
+
+bool utils::SlightRow::getEmptyCellZero(void) const {
+    return !m_empty_cell.empty();
+}
+
 void utils::SlightRow::process(void) {
     if (!m_input.size()) {
         throw slightrow_input_error();
@@ -78,40 +90,70 @@ void utils::SlightRow::process(void) {
         throw slightrow_separator_error();
     }
 
+    // single byte separator and escape characters are looked up in the transition table of the cell machine
+    if (m_dfa_enabled) {
+        size_t digit_count = this->processCells();
+        m_cell_count = m_cells.size();
+        m_is_header = getIsHeader(digit_count, m_input.size());
+        m_processed = true;
+        return;
+    }
+
     // define and declare variables used for processing row contents
     string cell = "";
     bool is_escaped = false;
+    // numeric characters are counted for header detection in the same pass
+    size_t digit_count = 0;
     char c;
     U8char in_u8_char;
     U8char u8_last_char;
+    // malformed input is reported after the loop (no exceptions are thrown byte by byte)
+    bool is_malformed = false;
     
     // iterate through all characters of input string
     for(size_t i = 0; i < m_input.size(); ++i) {
 
+        // copy the run of plain bytes up to the next separator (or non-ASCII character) at once
+        if (m_scan_enabled && !in_u8_char.size()) {
+            size_t run = m_scanner.find(m_input.data() + i, m_input.size() - i, is_escaped, digit_count);
+            if (run) {
+                cell.append(m_input, i, run);
+                i += run;
+                u8_last_char.clear();
+                u8_last_char.tryAddByte(m_input[i - 1]);
+                if (i == m_input.size()) {
+                    break;
+                }
+            }
+        }
+
         c = m_input[i];
+        if (c >= '0' && c <= '9') {
+            ++digit_count;
+        }
 
-        in_u8_char.addByte(c);
+        U8char::Status status = in_u8_char.tryAddByte(c);
+        if (status != U8char::STATUS_VALID && status != U8char::STATUS_INCOMPLETE) {
+            is_malformed = true;
+            break;
+        }
 
         // if UTF8 character is valid (complete)
-        if (in_u8_char) {
+        if (status == U8char::STATUS_VALID) {
 
             // if escape character is defined (not zero)
             if (m_esc) {
                 // if current character is escape character
-                if (in_u8_char == m_esc) {
+                if (in_u8_char.isEqual(m_esc)) {
                     // set escaped state by a XOR
                     // this is an efficient way of keeping track of escape state without using expensive "maps"
                     is_escaped ^= true;
                 }
             }
             // if character is not delimiter or it is escaped
-            if (in_u8_char != m_sep || is_escaped) {
+            if (!in_u8_char.isEqual(m_sep) || is_escaped) {
                 // add character to cell buffer
-                char char_buff[5] = {0};
-
-                in_u8_char.getBytes(char_buff, 4);
-
-                cell += char_buff;
+                cell += in_u8_char.getData();
             // if character is delimiter and it is not escaped
             } else {
                 // if cell buffer size is not zero
@@ -122,8 +164,8 @@ void utils::SlightRow::process(void) {
                     cell.clear();
                 // if cell buffer size is zero (empty field)
                 } else {
-                    // insert zero at the end of cells vector
-                    m_cells.push_back("0");
+                    // insert an empty cell at the end of cells vector
+                    m_cells.push_back(m_empty_cell);
                 }
             }
 
@@ -133,6 +175,10 @@ void utils::SlightRow::process(void) {
         }        
     }
 
+    if (is_malformed) {
+        throw u8char_format_error();
+    }
+
     // if there is remainder in cell buffer (row ending characters after last separator)
     if (cell.size()) {
         // insert it at the end of cells vector
@@ -140,14 +186,14 @@ void utils::SlightRow::process(void) {
     }
 
     // if last character in row is separator and it is not escaped
-    if (u8_last_char == m_sep && !is_escaped) {
-        // insert zero at the end of cells vector
-        m_cells.push_back("0");
+    if (u8_last_char.isEqual(m_sep) && !is_escaped) {
+        // insert an empty cell at the end of cells vector
+        m_cells.push_back(m_empty_cell);
     }
 
     m_cell_count = m_cells.size();
 
-    m_is_header = this->checkIsHeader();
+    m_is_header = getIsHeader(digit_count, m_input.size());
 
     m_processed = true;
 }
@@ -184,6 +230,8 @@ void utils::SlightRow::reset(void) {
     vector<string>().swap(m_cells);
     m_sep.clear();
     m_esc.clear();
+    m_empty_cell.clear();
+    this->setupTables();
 }
 
 bool utils::SlightRow::getIsHeader(void) const {
@@ -193,24 +241,101 @@ bool utils::SlightRow::getIsHeader(void) const {
     return m_is_header;
 }
 
-// TODO: examine the possibility of merging header verification with cells extraction in order to save one iteration
+bool utils::SlightRow::getIsHeader(const size_t t_digit_count, const size_t t_size) {
+    // if the ratio of numeric characters is at least 10 percents, the row is not considered a header
+    return !((float)t_digit_count / t_size > 0.1f);
+}
+
 // TODO: enhance header detection algorithm
-// TODO: make API capable of turning of automatic header detection in order to prevent problems that may arise from false
-// positives.
-bool utils::SlightRow::checkIsHeader(void) const {
-    float num_chars = 0;
-    // iterate through all characters of the input string
-    for (string::const_iterator it = m_input.begin(); it != m_input.end(); ++it) {
-        // if character is numeric, increase counter
-        if (*it >= 48 && *it <= 57) {
-            ++num_chars;
+size_t utils::SlightRow::processCells(void) {
+    const char *data = m_input.data();
+    const size_t size = m_input.size();
+    string cell = "";
+    SlightDfa::State state = SlightDfa::STATE_EMPTY;
+    // numeric characters are counted for header detection in the same pass
+    size_t digit_count = 0;
+    // malformed input is reported after the loop (no exceptions are thrown byte by byte)
+    bool is_malformed = false;
+
+    for (size_t i = 0; i < size && !is_malformed; ++i) {
+        // copy the run of plain bytes up to the next byte to look at at once
+        if (m_scan_enabled) {
+            bool is_escaped = state == SlightDfa::STATE_QUOTED;
+            size_t run = m_scanner.find(data + i, size - i, is_escaped, digit_count);
+            if (run) {
+                cell.append(data + i, run);
+                i += run;
+                state = is_escaped ? SlightDfa::STATE_QUOTED : SlightDfa::STATE_FIELD;
+                if (i == size) {
+                    break;
+                }
+            }
+        }
+        // take the action of the cell machine for the byte
+        if (data[i] >= '0' && data[i] <= '9') {
+            ++digit_count;
+        }
+        SlightDfa::State next = m_dfa.getNext(state, data[i]);
+        switch (m_dfa.getAction(state, data[i])) {
+            case SlightDfa::ACTION_COPY:
+                cell += data[i];
+                break;
+            case SlightDfa::ACTION_CELL_END:
+                m_cells.push_back(cell);
+                cell.clear();
+                break;
+            case SlightDfa::ACTION_EMPTY_CELL:
+                // empty cells are stored as null cells (or as zero)
+                m_cells.push_back(m_empty_cell);
+                break;
+            case SlightDfa::ACTION_MULTIBYTE: {
+                size_t length;
+                U8char::Status status = SlightDfa::checkChar(data + i, size - i, length);
+                if (status == U8char::STATUS_VALID) {
+                    cell.append(data + i, length);
+                    i += length - 1;
+                } else if (status == U8char::STATUS_INCOMPLETE) {
+                    // an incomplete character at the end of the row is dropped
+                    next = state;
+                    i = size;
+                } else {
+                    is_malformed = true;
+                }
+                break;
+            }
+            case SlightDfa::ACTION_ERROR:
+                is_malformed = true;
+                break;
+            default:
+                break;
         }
+        state = next;
     }
-    // if the ratio of numeric characters is at least 10 percents
-    if (num_chars / m_input.size() > 0.1f) {
-        // the row is not considered a header
-        return false;
+
+    if (is_malformed) {
+        throw u8char_format_error();
     }
-    // otherwise the row is considered a header
-    return true;
-}
\ No newline at end of file
+
+    // the last cell, or an empty cell if the row ends with a separator
+    if (state == SlightDfa::STATE_FIELD || state == SlightDfa::STATE_QUOTED) {
+        m_cells.push_back(cell);
+    } else if (state == SlightDfa::STATE_AFTER_SEPARATOR) {
+        m_cells.push_back(m_empty_cell);
+    }
+    return digit_count;
+}
+
+void utils::SlightRow::setupTables(void) {
+    // the separator is a target, the escape character toggles the escaped state, NUL bytes are dropped character by
+    // character (multibyte characters are always left to the character by character processing)
+    m_scanner.clear();
+    m_scan_enabled = m_scanner.addStop(0);
+    if (m_sep && m_sep.size() == 1) {
+        m_scan_enabled = m_scan_enabled && m_scanner.addTarget(m_sep.getByte(0));
+    }
+    if (m_esc && m_esc.size() == 1) {
+        m_scan_enabled = m_scan_enabled && m_scanner.setEscape(m_esc.getByte(0));
+    }
+    // the cell machine needs single byte separator and escape characters
+    m_dfa_enabled = m_sep && m_dfa.setupCells(m_sep, m_esc);
+}
@@ -22,6 +22,8 @@
 #include <exception>
 
 #include "u8char.hpp"
+#include "slightscan.hpp"
+#include "slightdfa.hpp"
 
 using std::string;
 using std::vector;
@@ -72,6 +74,19 @@ namespace utils {
             /// \see setEscape()
             void getEscape(U8char &t_target) const;
 
+            /// Method to select how empty fields are stored. By default, they are stored as null cells (empty strings,
+            /// no memory allocated for them), or as "0" (behavior of earlier versions). Changing the setting 
+            /// invalidates any previous processing results (it is necessary to process the row again before querying
+            /// results).
+            /// \param t_is_zero true to store empty fields as "0", false to store them as null cells.
+            /// \see getEmptyCellZero()
+            void setEmptyCellZero(const bool t_is_zero);
+
+            /// Method to get whether empty fields are stored as "0".
+            /// \return true if empty fields are stored as "0", false if they are stored as null cells.
+            /// \see setEmptyCellZero()
+            bool getEmptyCellZero(void) const;
+
             /// Method to process the row input string and export contents to cells. Input string and delimiter character
             /// settings are required before triggering processing. If those settings are not provided, an excpetion is 
             /// thrown.
@@ -96,6 +111,14 @@ namespace utils {
             /// \see getCells()
             bool getIsHeader(void) const;
 
+            /// Method to apply the header detection rule to the statistics of a row: a row is considered a header if
+            /// at most 10 percent of its bytes are numeric characters.
+            /// \param t_digit_count number of numeric characters ('0' to '9') in the row.
+            /// \param t_size size of the row in bytes.
+            /// \return header flag.
+            /// \overload
+            static bool getIsHeader(const size_t t_digit_count, const size_t t_size);
+
             /// Method to clear the processing results related fields of the row. Input string, delimiter and escape 
             /// character settings are preserved.
             /// \see reset()
@@ -111,11 +134,18 @@ namespace utils {
             void reset(void);  
 
         private:
-            bool checkIsHeader(void) const;
+            size_t processCells(void);
+            void setupTables(void);
 
             string m_input;
             U8char m_sep;
             U8char m_esc;
+            // contents of the cells of empty fields (empty for null cells)
+            string m_empty_cell;
+            SlightScanner m_scanner;
+            bool m_scan_enabled;
+            SlightDfa m_dfa;
+            bool m_dfa_enabled;
             bool m_processed;
             vector<string> m_cells;
             size_t m_cell_count;
@@ -0,0 +1,512 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "slightscan.hpp"
+
+#include <cstring>
+#include <stdint.h>
+
+// SIMD paths need x86 intrinsics and per-function target attributes (GCC and Clang), the rest of the library is
+// built for the baseline instruction set
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SLIGHTSCAN_X86
+#include <immintrin.h>
+#endif
+
+// byte classes (bit flags)
+static const unsigned char CLASS_TARGET = 1;
+static const unsigned char CLASS_STOP = 2;
+static const unsigned char CLASS_ESCAPE = 4;
+
+// number of bytes scanned at once (bits of a mask)
+static const size_t BLOCK_SIZE = 64;
+
+// masks of a block: bit i is set if byte i of the block belongs to the class
+struct BlockMasks {
+    uint64_t m_target;
+    uint64_t m_stop;
+    uint64_t m_escape;
+    uint64_t m_digit;
+};
+
+// masks of a block for UTF-8 validation: bit i is set if byte i of the block has the most significant bit set, is a
+// continuation byte (0x80-0xbf) or is below 0xe0, 0xf0 or 0xf8 (and not ASCII)
+struct Utf8Masks {
+    uint64_t m_high;
+    uint64_t m_cont;
+    uint64_t m_below_e0;
+    uint64_t m_below_f0;
+    uint64_t m_below_f8;
+};
+
+// add the mask of the bytes equal to a searched byte to the masks of its classes
+static inline void addMask(BlockMasks &t_masks, const uint64_t t_mask, const unsigned char t_class) {
+    if (t_class & CLASS_TARGET) {
+        t_masks.m_target |= t_mask;
+    }
+    if (t_class & CLASS_STOP) {
+        t_masks.m_stop |= t_mask;
+    }
+    if (t_class & CLASS_ESCAPE) {
+        t_masks.m_escape |= t_mask;
+    }
+}
+
+#ifdef SLIGHTSCAN_X86
+
+static void getMasksSse2(const char *t_block, const char *t_bytes, const unsigned char *t_classes,
+    const size_t t_byte_count, const bool t_digits, const bool t_multibyte, BlockMasks &t_masks) {
+    __m128i v[4];
+    for (int k = 0; k < 4; ++k) {
+        v[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_block + k * 16));
+    }
+    // bytes of multibyte UTF-8 characters (most significant bit set)
+    if (t_multibyte) {
+        uint64_t high = 0;
+        for (int k = 0; k < 4; ++k) {
+            high |= (uint64_t)(unsigned)_mm_movemask_epi8(v[k]) << (k * 16);
+        }
+        t_masks.m_stop |= high;
+    }
+    for (size_t i = 0; i < t_byte_count; ++i) {
+        __m128i c = _mm_set1_epi8(t_bytes[i]);
+        uint64_t mask = 0;
+        for (int k = 0; k < 4; ++k) {
+            mask |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v[k], c)) << (k * 16);
+        }
+        addMask(t_masks, mask, t_classes[i]);
+    }
+    // numeric characters (byte - '0' is at most 9 as an unsigned number)
+    if (t_digits) {
+        for (int k = 0; k < 4; ++k) {
+            __m128i d = _mm_sub_epi8(v[k], _mm_set1_epi8('0'));
+            t_masks.m_digit |= (uint64_t)(unsigned)_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d)) << (k * 16);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void getMasksAvx2(const char *t_block, const char *t_bytes, const unsigned char *t_classes,
+    const size_t t_byte_count, const bool t_digits, const bool t_multibyte, BlockMasks &t_masks) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_block));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_block + 32));
+    if (t_multibyte) {
+        t_masks.m_stop |= (uint64_t)(unsigned)_mm256_movemask_epi8(lo) |
+            ((uint64_t)(unsigned)_mm256_movemask_epi8(hi) << 32);
+    }
+    for (size_t i = 0; i < t_byte_count; ++i) {
+        __m256i c = _mm256_set1_epi8(t_bytes[i]);
+        uint64_t mask = (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, c)) |
+            ((uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, c)) << 32);
+        addMask(t_masks, mask, t_classes[i]);
+    }
+    if (t_digits) {
+        __m256i zero = _mm256_set1_epi8('0');
+        __m256i nine = _mm256_set1_epi8(9);
+        __m256i dlo = _mm256_sub_epi8(lo, zero);
+        __m256i dhi = _mm256_sub_epi8(hi, zero);
+        t_masks.m_digit |= (uint64_t)(unsigned)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_min_epu8(dlo, nine), dlo)) |
+            ((uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(dhi, nine), dhi)) << 32);
+    }
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void getMasksAvx512(const char *t_block, const char *t_bytes, const unsigned char *t_classes,
+    const size_t t_byte_count, const bool t_digits, const bool t_multibyte, BlockMasks &t_masks) {
+    __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(t_block));
+    if (t_multibyte) {
+        t_masks.m_stop |= _mm512_movepi8_mask(v);
+    }
+    for (size_t i = 0; i < t_byte_count; ++i) {
+        addMask(t_masks, _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(t_bytes[i])), t_classes[i]);
+    }
+    if (t_digits) {
+        t_masks.m_digit |= _mm512_cmple_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8('0')), _mm512_set1_epi8(9));
+    }
+}
+
+// masks of a block for UTF-8 validation (bytes compared as signed values, ASCII bytes are not negative)
+static void getUtf8MasksSse2(const char *t_block, Utf8Masks &t_masks) {
+    __m128i v[4];
+    for (int k = 0; k < 4; ++k) {
+        v[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_block + k * 16));
+        t_masks.m_high |= (uint64_t)(unsigned)_mm_movemask_epi8(v[k]) << (k * 16);
+    }
+    if (!t_masks.m_high) {
+        return;
+    }
+    for (int k = 0; k < 4; ++k) {
+        t_masks.m_cont |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(v[k], _mm_set1_epi8(-64))) << 
+            (k * 16);
+        t_masks.m_below_e0 |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(v[k], _mm_set1_epi8(-32))) << 
+            (k * 16);
+        t_masks.m_below_f0 |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(v[k], _mm_set1_epi8(-16))) << 
+            (k * 16);
+        t_masks.m_below_f8 |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(v[k], _mm_set1_epi8(-8))) << 
+            (k * 16);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline uint64_t getLessMaskAvx2(const __m256i t_lo, const __m256i t_hi, const char t_limit) {
+    __m256i limit = _mm256_set1_epi8(t_limit);
+    return (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, t_lo)) |
+        ((uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, t_hi)) << 32);
+}
+
+__attribute__((target("avx2")))
+static void getUtf8MasksAvx2(const char *t_block, Utf8Masks &t_masks) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_block));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_block + 32));
+    t_masks.m_high = (uint64_t)(unsigned)_mm256_movemask_epi8(lo) |
+        ((uint64_t)(unsigned)_mm256_movemask_epi8(hi) << 32);
+    if (!t_masks.m_high) {
+        return;
+    }
+    t_masks.m_cont = getLessMaskAvx2(lo, hi, -64);
+    t_masks.m_below_e0 = getLessMaskAvx2(lo, hi, -32);
+    t_masks.m_below_f0 = getLessMaskAvx2(lo, hi, -16);
+    t_masks.m_below_f8 = getLessMaskAvx2(lo, hi, -8);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void getUtf8MasksAvx512(const char *t_block, Utf8Masks &t_masks) {
+    __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(t_block));
+    t_masks.m_high = _mm512_movepi8_mask(v);
+    if (!t_masks.m_high) {
+        return;
+    }
+    t_masks.m_cont = _mm512_cmplt_epi8_mask(v, _mm512_set1_epi8(-64));
+    t_masks.m_below_e0 = _mm512_cmplt_epi8_mask(v, _mm512_set1_epi8(-32));
+    t_masks.m_below_f0 = _mm512_cmplt_epi8_mask(v, _mm512_set1_epi8(-16));
+    t_masks.m_below_f8 = _mm512_cmplt_epi8_mask(v, _mm512_set1_epi8(-8));
+}
+
+#endif // SLIGHTSCAN_X86
+
+// bit i of the result is the XOR of bits 0..i of the input (escaped state after each byte of the block)
+static inline uint64_t prefixXor(uint64_t t_mask) {
+    t_mask ^= t_mask << 1;
+    t_mask ^= t_mask << 2;
+    t_mask ^= t_mask << 4;
+    t_mask ^= t_mask << 8;
+    t_mask ^= t_mask << 16;
+    t_mask ^= t_mask << 32;
+    return t_mask;
+}
+
+static inline bool getParity(const uint64_t t_mask) {
+    return __builtin_popcountll(t_mask) & 1;
+}
+
+static inline bool isDigit(const char t_byte) {
+    return (unsigned char)(t_byte - '0') < 10;
+}
+
+// number of bytes of a UTF-8 character from its lead byte, 0 if the byte cannot begin a character
+static size_t getLengthFromByte(const unsigned char t_byte) {
+    if (t_byte < 0x80) {
+        return 1;
+    }
+    if ((t_byte & 0xe0) == 0xc0) {
+        return 2;
+    }
+    if ((t_byte & 0xf0) == 0xe0) {
+        return 3;
+    }
+    if ((t_byte & 0xf8) == 0xf0) {
+        return 4;
+    }
+    return 0;
+}
+
+// check the continuation bytes of a block: the lead bytes require continuation bytes right after them (carried over to
+// the next block if needed), and there must be no other continuation bytes
+static inline bool checkUtf8Block(const Utf8Masks &t_masks, uint64_t &t_carry) {
+    uint64_t lead_2 = t_masks.m_below_e0 & ~t_masks.m_cont;
+    uint64_t lead_3 = t_masks.m_below_f0 & ~t_masks.m_below_e0;
+    uint64_t lead_4 = t_masks.m_below_f8 & ~t_masks.m_below_f0;
+    uint64_t invalid = t_masks.m_high & ~t_masks.m_below_f8;
+    uint64_t lead_any = lead_2 | lead_3 | lead_4;
+    uint64_t lead_long = lead_3 | lead_4;
+    uint64_t required = (lead_any << 1) | (lead_long << 2) | (lead_4 << 3) | t_carry;
+    t_carry = (lead_any >> 63) | (lead_long >> 62) | (lead_4 >> 61);
+    return !invalid && required == t_masks.m_cont;
+}
+
+// detect the instruction sets supported by the processor
+static utils::SlightScanner::InstructionSet detectInstructionSet(void) {
+#ifdef SLIGHTSCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        return utils::SlightScanner::ISET_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return utils::SlightScanner::ISET_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return utils::SlightScanner::ISET_SSE2;
+    }
+#endif
+    return utils::SlightScanner::ISET_SCALAR;
+}
+
+utils::SlightScanner::InstructionSet utils::SlightScanner::getBestInstructionSet(void) {
+    // detected once
+    static const InstructionSet best = detectInstructionSet();
+    return best;
+}
+
+utils::SlightScanner::SlightScanner(void) {
+    m_iset = getBestInstructionSet();
+    m_multibyte_stop = true;
+    clear();
+}
+
+void utils::SlightScanner::setInstructionSet(const InstructionSet t_iset) {
+    InstructionSet best = getBestInstructionSet();
+    m_iset = t_iset > best ? best : t_iset;
+}
+
+utils::SlightScanner::InstructionSet utils::SlightScanner::getInstructionSet(void) const {
+    return m_iset;
+}
+
+void utils::SlightScanner::clear(void) {
+    m_byte_count = 0;
+    memset(m_byte_classes, 0, sizeof(m_byte_classes));
+    setMultibyteStop(m_multibyte_stop);
+}
+
+void utils::SlightScanner::setMultibyteStop(const bool t_is_stop) {
+    m_multibyte_stop = t_is_stop;
+    // bytes of multibyte UTF-8 characters are reported unless they are known to be valid
+    for (int i = 0x80; i < 0x100; ++i) {
+        m_byte_classes[i] = t_is_stop ? CLASS_STOP : 0;
+    }
+}
+
+bool utils::SlightScanner::getMultibyteStop(void) const {
+    return m_multibyte_stop;
+}
+
+bool utils::SlightScanner::addTarget(const char t_byte) {
+    return addByte(t_byte, CLASS_TARGET);
+}
+
+bool utils::SlightScanner::addStop(const char t_byte) {
+    return addByte(t_byte, CLASS_STOP);
+}
+
+bool utils::SlightScanner::setEscape(const char t_byte) {
+    return addByte(t_byte, CLASS_ESCAPE);
+}
+
+bool utils::SlightScanner::addByte(const char t_byte, const unsigned char t_class) {
+    unsigned char byte = t_byte;
+    if (byte & 0x80) {
+        return false;
+    }
+    // a byte added again gets the new class as well
+    for (size_t i = 0; i < m_byte_count; ++i) {
+        if (m_bytes[i] == t_byte) {
+            m_classes[i] |= t_class;
+            m_byte_classes[byte] |= t_class;
+            return true;
+        }
+    }
+    if (m_byte_count == MAX_BYTE_COUNT) {
+        return false;
+    }
+    m_bytes[m_byte_count] = t_byte;
+    m_classes[m_byte_count] = t_class;
+    ++m_byte_count;
+    m_byte_classes[byte] |= t_class;
+    return true;
+}
+
+size_t utils::SlightScanner::find(const char *t_data, const size_t t_size, bool &t_is_escaped) const {
+    return findBytes(t_data, t_size, t_is_escaped, 0);
+}
+
+size_t utils::SlightScanner::find(const char *t_data, const size_t t_size, bool &t_is_escaped, 
+    size_t &t_digit_count) const {
+    return findBytes(t_data, t_size, t_is_escaped, &t_digit_count);
+}
+
+size_t utils::SlightScanner::findBytes(const char *t_data, const size_t t_size, bool &t_is_escaped, 
+    size_t *t_digit_count) const {
+    bool is_escaped = t_is_escaped;
+
+    if (m_iset == ISET_SCALAR) {
+        for (size_t i = 0; i < t_size; ++i) {
+            unsigned char byte_class = m_byte_classes[(unsigned char)t_data[i]];
+            if (byte_class & CLASS_STOP) {
+                t_is_escaped = is_escaped;
+                return i;
+            }
+            if (byte_class & CLASS_ESCAPE) {
+                is_escaped ^= true;
+            } else if ((byte_class & CLASS_TARGET) && !is_escaped) {
+                t_is_escaped = is_escaped;
+                return i;
+            }
+            if (t_digit_count && isDigit(t_data[i])) {
+                ++*t_digit_count;
+            }
+        }
+        t_is_escaped = is_escaped;
+        return t_size;
+    }
+
+#ifdef SLIGHTSCAN_X86
+    char tail[BLOCK_SIZE];
+    for (size_t offset = 0; offset < t_size; offset += BLOCK_SIZE) {
+        const char *block = t_data + offset;
+        uint64_t valid = ~(uint64_t)0;
+        // the last partial block is scanned from a copy (reading past the end of the data is not allowed)
+        if (t_size - offset < BLOCK_SIZE) {
+            memset(tail, 0, BLOCK_SIZE);
+            memcpy(tail, block, t_size - offset);
+            block = tail;
+            valid = ((uint64_t)1 << (t_size - offset)) - 1;
+        }
+
+        BlockMasks masks = {0, 0, 0, 0};
+        switch (m_iset) {
+            case ISET_AVX512:
+                getMasksAvx512(block, m_bytes, m_classes, m_byte_count, t_digit_count != 0, m_multibyte_stop, masks);
+                break;
+            case ISET_AVX2:
+                getMasksAvx2(block, m_bytes, m_classes, m_byte_count, t_digit_count != 0, m_multibyte_stop, masks);
+                break;
+            default:
+                getMasksSse2(block, m_bytes, m_classes, m_byte_count, t_digit_count != 0, m_multibyte_stop, masks);
+                break;
+        }
+
+        // stop bytes take precedence (they do not toggle the escaped state), escape bytes are never targets
+        uint64_t stop = masks.m_stop & valid;
+        uint64_t escape = masks.m_escape & ~stop & valid;
+        uint64_t target = masks.m_target & ~stop & ~escape & valid;
+
+        // escaped regions of the block, continuing the state of the previous block
+        uint64_t inside = prefixXor(escape);
+        if (is_escaped) {
+            inside = ~inside;
+        }
+
+        uint64_t found = stop | (target & ~inside);
+        if (found) {
+            unsigned index = __builtin_ctzll(found);
+            // escaped state before the byte found
+            uint64_t before = index ? (((uint64_t)1 << index) - 1) : 0;
+            t_is_escaped = is_escaped ^ getParity(escape & before);
+            if (t_digit_count) {
+                *t_digit_count += __builtin_popcountll(masks.m_digit & before);
+            }
+            return offset + index;
+        }
+        is_escaped ^= getParity(escape);
+        if (t_digit_count) {
+            *t_digit_count += __builtin_popcountll(masks.m_digit & valid);
+        }
+    }
+#endif
+
+    t_is_escaped = is_escaped;
+    return t_size;
+}
+
+utils::SlightUtf8Validator::SlightUtf8Validator(void) {
+    m_iset = SlightScanner::getBestInstructionSet();
+}
+
+void utils::SlightUtf8Validator::setInstructionSet(const SlightScanner::InstructionSet t_iset) {
+    SlightScanner::InstructionSet best = SlightScanner::getBestInstructionSet();
+    m_iset = t_iset > best ? best : t_iset;
+}
+
+utils::SlightScanner::InstructionSet utils::SlightUtf8Validator::getInstructionSet(void) const {
+    return m_iset;
+}
+
+bool utils::SlightUtf8Validator::validate(const char *t_data, const size_t t_size) const {
+
+    if (m_iset == SlightScanner::ISET_SCALAR) {
+        size_t i = 0;
+        while (i < t_size) {
+            size_t length = getLengthFromByte(t_data[i]);
+            if (!length || length > t_size - i) {
+                return false;
+            }
+            for (size_t j = 1; j < length; ++j) {
+                if ((t_data[i + j] & 0xc0) != 0x80) {
+                    return false;
+                }
+            }
+            i += length;
+        }
+        return true;
+    }
+
+    // continuation bytes required at the beginning of the next block
+    uint64_t carry = 0;
+#ifdef SLIGHTSCAN_X86
+    char tail[BLOCK_SIZE];
+    for (size_t offset = 0; offset < t_size; offset += BLOCK_SIZE) {
+        const char *block = t_data + offset;
+        // the last partial block is checked from a copy padded with ASCII bytes, so characters continuing past the
+        // end of the data lack their continuation bytes
+        if (t_size - offset < BLOCK_SIZE) {
+            memset(tail, 0, BLOCK_SIZE);
+            memcpy(tail, block, t_size - offset);
+            block = tail;
+        }
+
+        Utf8Masks masks = {0, 0, 0, 0, 0};
+        switch (m_iset) {
+            case SlightScanner::ISET_AVX512:
+                getUtf8MasksAvx512(block, masks);
+                break;
+            case SlightScanner::ISET_AVX2:
+                getUtf8MasksAvx2(block, masks);
+                break;
+            default:
+                getUtf8MasksSse2(block, masks);
+                break;
+        }
+        if (!checkUtf8Block(masks, carry)) {
+            return false;
+        }
+    }
+#endif
+
+    return !carry;
+}
+
+size_t utils::SlightUtf8Validator::getIncompleteSize(const char *t_data, const size_t t_size) {
+    // the lead byte of a character is at most 3 bytes before the end if the character is incomplete
+    for (size_t size = 1; size <= 3 && size <= t_size; ++size) {
+        unsigned char byte = t_data[t_size - size];
+        if ((byte & 0xc0) != 0x80) {
+            return getLengthFromByte(byte) > size ? size : 0;
+        }
+    }
+    return 0;
+}
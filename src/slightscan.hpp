@@ -0,0 +1,171 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef _UTILS_SLIGHTSCAN_HPP
+#define _UTILS_SLIGHTSCAN_HPP
+
+#include <cstddef>
+
+namespace utils {
+
+    /// Structural character scanner of the library. It finds the next byte the parser has to look at (e.g. separator,
+    /// new line) in blocks of 64 bytes using SIMD instructions (SSE2, AVX2 or AVX-512, chosen at runtime), so runs of
+    /// plain bytes between them can be copied at once instead of character by character. Escaped regions are
+    /// resolved with bitmask arithmetic (prefix XOR of the escape character positions): target bytes inside them are
+    /// not reported. Only single byte (ASCII) characters can be searched for, every byte with the most significant
+    /// bit set (part of a multibyte UTF-8 character) is reported as a stop byte unless the input is validated already.
+    class SlightScanner {
+
+        public:
+            /// Instruction set used for scanning.
+            enum InstructionSet {
+                /// Portable byte by byte scanning.
+                ISET_SCALAR,
+                /// 16 bytes per instruction (baseline of x86-64).
+                ISET_SSE2,
+                /// 32 bytes per instruction.
+                ISET_AVX2,
+                /// 64 bytes per instruction.
+                ISET_AVX512
+            };
+
+            /// Maximum number of bytes (targets, stop bytes and the escape byte together) searched for.
+            static const size_t MAX_BYTE_COUNT = 8;
+
+            /// Default constructor of the class. The best instruction set supported by the processor is selected.
+            SlightScanner(void);
+
+            /// Method to get the best instruction set supported by the processor (and the build).
+            /// \return instruction set.
+            static InstructionSet getBestInstructionSet(void);
+
+            /// Method to select the instruction set used for scanning (e.g. for testing or benchmarking). An
+            /// instruction set not supported by the processor falls back to the best supported one.
+            /// \param t_iset instruction set.
+            /// \see getInstructionSet()
+            void setInstructionSet(const InstructionSet t_iset);
+
+            /// Method to get the instruction set used for scanning.
+            /// \return instruction set.
+            /// \see setInstructionSet()
+            InstructionSet getInstructionSet(void) const;
+
+            /// Method to remove all bytes searched for (the instruction set and the multibyte stop setting are kept).
+            void clear(void);
+
+            /// Method to select whether the bytes of multibyte UTF-8 characters are stop bytes (default). If they
+            /// are not, runs of multibyte characters are passed over like plain bytes, for input checked already
+            /// (see SlightUtf8Validator).
+            /// \param t_is_stop true if the bytes with the most significant bit set are reported.
+            /// \see getMultibyteStop()
+            void setMultibyteStop(const bool t_is_stop);
+
+            /// Method to get whether the bytes of multibyte UTF-8 characters are stop bytes.
+            /// \return true if the bytes with the most significant bit set are reported.
+            /// \see setMultibyteStop()
+            bool getMultibyteStop(void) const;
+
+            /// Method to add a target byte. Target bytes are reported only outside escaped regions.
+            /// \param t_byte target byte (ASCII).
+            /// \return false if the byte cannot be searched for (not ASCII or too many bytes), true otherwise.
+            bool addTarget(const char t_byte);
+
+            /// Method to add a stop byte. Stop bytes are always reported (they do not toggle the escaped state, even
+            /// if they match the escape byte).
+            /// \param t_byte stop byte (ASCII).
+            /// \return false if the byte cannot be searched for (not ASCII or too many bytes), true otherwise.
+            bool addStop(const char t_byte);
+
+            /// Method to set the escape byte, toggling the escaped state. Optional, there are no escaped regions
+            /// without it.
+            /// \param t_byte escape byte (ASCII).
+            /// \return false if the byte cannot be searched for (not ASCII or too many bytes), true otherwise.
+            bool setEscape(const char t_byte);
+
+            /// Method to find the first byte to report (a stop byte, or a target byte outside escaped regions).
+            /// \param t_data pointer to the first byte to scan.
+            /// \param t_size number of bytes to scan.
+            /// \param t_is_escaped escaped state before the first byte, updated to the state before the byte found
+            /// (or after the last byte if none is found).
+            /// \return index of the byte found, t_size if none is found.
+            size_t find(const char *t_data, const size_t t_size, bool &t_is_escaped) const;
+
+            /// Method to find the first byte to report, counting the numeric characters ('0' to '9') before it at the
+            /// same time (statistics of header detection).
+            /// \param t_data pointer to the first byte to scan.
+            /// \param t_size number of bytes to scan.
+            /// \param t_is_escaped escaped state before the first byte, updated as by find().
+            /// \param t_digit_count increased by the number of numeric characters before the byte found.
+            /// \return index of the byte found, t_size if none is found.
+            /// \overload
+            size_t find(const char *t_data, const size_t t_size, bool &t_is_escaped, size_t &t_digit_count) const;
+
+        private:
+            size_t findBytes(const char *t_data, const size_t t_size, bool &t_is_escaped, size_t *t_digit_count) const;
+            bool addByte(const char t_byte, const unsigned char t_class);
+
+            InstructionSet m_iset;
+            bool m_multibyte_stop;
+            char m_bytes[MAX_BYTE_COUNT];
+            unsigned char m_classes[MAX_BYTE_COUNT];
+            size_t m_byte_count;
+            unsigned char m_byte_classes[256];
+
+    };
+
+    /// UTF-8 validator of the library. It checks whole chunks of input in blocks of 64 bytes with the SIMD instruction
+    /// set of the scanner: the lead bytes and the continuation bytes of a block are turned into bitmasks, and the 
+    /// positions where continuation bytes are required (derived from the lead bytes by shifts) are compared with the 
+    /// positions where they are found. Blocks of ASCII bytes only are passed over at once. Sequences are checked 
+    /// structurally, the same way as by U8char (lead byte and the number of continuation bytes).
+    class SlightUtf8Validator {
+
+        public:
+            /// Default constructor of the class. The best instruction set supported by the processor is selected.
+            SlightUtf8Validator(void);
+
+            /// Method to select the instruction set used for validation (e.g. for testing or benchmarking). An
+            /// instruction set not supported by the processor falls back to the best supported one.
+            /// \param t_iset instruction set.
+            /// \see getInstructionSet()
+            void setInstructionSet(const SlightScanner::InstructionSet t_iset);
+
+            /// Method to get the instruction set used for validation.
+            /// \return instruction set.
+            /// \see setInstructionSet()
+            SlightScanner::InstructionSet getInstructionSet(void) const;
+
+            /// Method to check whether the bytes are complete, valid UTF-8 characters.
+            /// \param t_data bytes to check.
+            /// \param t_size number of bytes.
+            /// \return true if the bytes are valid (a character continuing past the end is invalid), false otherwise.
+            bool validate(const char *t_data, const size_t t_size) const;
+
+            /// Method to get the number of bytes of an incomplete character at the end of the bytes (a character 
+            /// continuing in the next chunk of input).
+            /// \param t_data bytes to check.
+            /// \param t_size number of bytes.
+            /// \return number of bytes from the lead byte of the incomplete character, 0 if there is none.
+            static size_t getIncompleteSize(const char *t_data, const size_t t_size);
+
+        private:
+            SlightScanner::InstructionSet m_iset;
+
+    };
+
+} // utils
+
+#endif // _UTILS_SLIGHTSCAN_HPP
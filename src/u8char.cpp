@@ -43,6 +43,9 @@ void utils::U8char::addByte(const byte t_byte) {
     // if byte is first, get the total number of bytes and invalidate object
     if (!m_current_count) {
         m_size = getSizeFromByte(t_byte);
+        if (!m_size) {
+            throw u8char_format_error();
+        }
         m_valid = false;
     }
     // add byte and increment count
@@ -54,6 +57,35 @@ void utils::U8char::addByte(const byte t_byte) {
     }
 }
 
+utils::U8char::Status utils::U8char::tryAddByte(const byte t_byte) {
+    if (!m_current_count) {
+        // if byte is first, get the total number of bytes and invalidate object
+        int size = getSizeFromByte(t_byte);
+        if (!size) {
+            return STATUS_INVALID_LEAD;
+        }
+        m_size = size;
+        m_valid = false;
+    } else if (m_current_count == m_size) {
+        return STATUS_TOO_LONG;
+    } else if ((t_byte & 0xc0) != 0x80) {
+        // byte's most significant bits are not '10'
+        return STATUS_INVALID_CONTINUATION;
+    }
+    // add byte and increment count
+    m_bytes[m_current_count] = t_byte;
+    ++m_current_count;
+    if (m_current_count < m_size) {
+        return STATUS_INCOMPLETE;
+    }
+    this->validate();
+    return m_valid ? STATUS_VALID : STATUS_INVALID_CONTINUATION;
+}
+
+int utils::U8char::getCount(void) const {
+    return m_current_count;
+}
+
 int utils::U8char::size(void) const {
     return m_size;
 }
@@ -101,6 +133,14 @@ string utils::U8char::getString(void) const {
     return u8_str;
 }
 
+const byte* utils::U8char::getData(void) const {
+    return m_bytes;
+}
+
+bool utils::U8char::isEqual(U8char const &t_u8char) const {
+    return m_valid && t_u8char.m_valid && !compareBytes(t_u8char);
+}
+
 void utils::U8char::clear(void) {
     // clear bytes
     for (int i = 0; i < 5; ++i) {
@@ -122,14 +162,10 @@ int utils::U8char::getSizeFromByte(const byte t_byte) {
         }
     }
 
-    // if bit with zero not found in the most significant 5 bits of the first byte
-    if (test_size == -1) {
-        throw u8char_format_error();
-    }
-
-    // if first byte's most significant bits are '10'
-    if (test_size == 1) {
-        throw u8char_format_error();
+    // if bit with zero not found in the most significant 5 bits of the first byte, or if first byte's most 
+    // significant bits are '10' (invalid first byte)
+    if (test_size == -1 || test_size == 1) {
+        return 0;
     }
 
     // if first byte's most significant bit is 0 (plain ASCII char)
@@ -170,6 +206,10 @@ int utils::U8char::compare(U8char const &t_u8char) const {
     if (!m_valid || !(t_u8char.isValid())) {
         throw u8char_format_error();
     }
+    return compareBytes(t_u8char);
+}
+
+int utils::U8char::compareBytes(U8char const &t_u8char) const {
 
     // if current object's size is less
     if (m_size < t_u8char.size()) {
@@ -182,10 +222,10 @@ int utils::U8char::compare(U8char const &t_u8char) const {
     // if size of the two objects are equal, iterate throught the individual bytes
     for (int i = 0; i < m_size; ++i) {
         // current object's byte is less
-        if (m_bytes[i] < t_u8char[i]) {
+        if (m_bytes[i] < t_u8char.m_bytes[i]) {
             return -1;
         // current object's byte is greater
-        } else if (m_bytes[i] > t_u8char[i]) {
+        } else if (m_bytes[i] > t_u8char.m_bytes[i]) {
             return 1;
         }
     }
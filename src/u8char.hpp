@@ -32,6 +32,22 @@ namespace utils {
     class U8char {
 
         public:
+            /// Status codes of adding a byte to an UTF-8 character without exceptions (see tryAddByte()).
+            enum Status {
+                /// The character is complete and valid.
+                STATUS_VALID,
+                /// The character is valid so far, more bytes are expected.
+                STATUS_INCOMPLETE,
+                /// The byte cannot begin an UTF-8 character (continuation byte or invalid length indication). The byte 
+                /// is not added.
+                STATUS_INVALID_LEAD,
+                /// The byte is not a continuation byte, but the character is incomplete. The byte is not added, the 
+                /// bytes added before form an invalid sequence (the byte may begin the next character).
+                STATUS_INVALID_CONTINUATION,
+                /// The character is complete already. The byte is not added.
+                STATUS_TOO_LONG
+            };
+
             /// Default constructor of the class.
             /// \see U8char(const byte* const t_bytes)
             U8char(void);
@@ -49,6 +65,18 @@ namespace utils {
             /// \see getBytes()
             /// \see getString()
             void addByte(const byte t_char);
+
+            /// Method to add an incoming byte to an UTF-8 character without throwing exceptions. Unlike addByte(), 
+            /// continuation bytes are checked as they are added, and an invalid byte is not added to the object.
+            /// \param t_char byte to be added to the UTF-8 character object.
+            /// \return status of the UTF-8 character after adding the byte.
+            /// \see addByte()
+            Status tryAddByte(const byte t_char);
+
+            /// Method to get the number of bytes added to the UTF-8 character so far.
+            /// \return the number of bytes added.
+            /// \see size()
+            int getCount(void) const;
             
             /// Method the get the number of bytes the UTF-8 character consists of. It is determined after adding 
             /// the first byte of the UTF-8 character.
@@ -89,6 +117,18 @@ namespace utils {
             /// \see getByte()
             /// \see getBytes()
             string getString(void) const;
+
+            /// Method to get the bytes added to the UTF-8 character (zero terminated), without checking the validity 
+            /// of the object (no exceptions).
+            /// \return pointer to the bytes held by the object.
+            /// \see getBytes()
+            const byte* getData(void) const;
+
+            /// Method to compare two UTF-8 character objects without throwing exceptions. An invalid object is not 
+            /// equal to any other object.
+            /// \param t_u8char UTF-8 character object to compare the current UTF-8 character object to.
+            /// \return true if both objects are valid and represent the same character.
+            bool isEqual(U8char const &t_u8char) const;
             
             /// Method to clear the UTF-8 character object. After calling the method, the object can be reused to represent
             /// another UTF-8 character.
@@ -135,9 +175,10 @@ namespace utils {
             operator bool() const;
         
         private:
-            int getSizeFromByte(const char t_byte);
+            static int getSizeFromByte(const char t_byte);
             void validate(void);
             int compare(U8char const &t_u8char) const;
+            int compareBytes(U8char const &t_u8char) const;
             byte m_bytes[5];
             int m_size;
             int m_current_count;
@@ -19,4 +19,5 @@
 #include "test_slightrow.cpp"
 #include "test_slightmatrix.cpp"
 #include "test_slightcsv.cpp"
-#include "test_u8char.cpp"
\ No newline at end of file
+#include "test_u8char.cpp"
+#include "test_slightinput.cpp"
\ No newline at end of file
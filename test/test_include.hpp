@@ -21,6 +21,9 @@
 #include "slightmatrix.hpp"
 #include "slightcsv.hpp"
 #include "u8char.hpp"
+#include "slightinput.hpp"
+#include "slightscan.hpp"
+#include "slightdfa.hpp"
 
 #include "CppUTest/TestHarness.h"
 
@@ -39,5 +42,15 @@ using utils::SlightRow;
 using utils::SlightMatrix;
 using utils::SlightCSV;
 using utils::U8char;
+using utils::SlightMemoryInput;
+using utils::SlightFileInput;
+using utils::SlightMmapInput;
+using utils::SlightReadAheadInput;
+using utils::SlightUringInput;
+using utils::SlightDecompressInput;
+using utils::SlightStreamInput;
+using utils::SlightScanner;
+using utils::SlightUtf8Validator;
+using utils::SlightDfa;
 
 #endif // _TEST_INCLUDE_HPP
\ No newline at end of file
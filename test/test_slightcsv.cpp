@@ -16,6 +16,11 @@
 
 #include "test_include.hpp"
 
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+#include <sys/stat.h>
+
 TEST_GROUP(slightcsv) {
 };
 
@@ -1907,4 +1912,2156 @@ TEST(slightcsv, replace_too_long_ex) {
         ex = e.what();
     }
     CHECK_EQUAL("Replace character invalid or missing.", ex);
-};
\ No newline at end of file
+};
+TEST(slightcsv, read_mode_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(SlightCSV::READ_MODE_STDIO, scsv.getReadMode());
+};
+
+TEST(slightcsv, read_mode_reset) {
+    SlightCSV scsv;
+    scsv.setReadMode(SlightCSV::READ_MODE_MMAP);
+    CHECK_EQUAL(SlightCSV::READ_MODE_MMAP, scsv.getReadMode());
+    scsv.reset();
+    CHECK_EQUAL(SlightCSV::READ_MODE_STDIO, scsv.getReadMode());
+};
+
+TEST(slightcsv, load_data_mmap_wrong_filename) {
+    SlightCSV scsv;
+    string t = "";
+    try {
+        scsv.setFileName("abc.def");
+        scsv.setSeparator(";");
+        scsv.setReadMode(SlightCSV::READ_MODE_MMAP);
+        scsv.loadData();
+    } catch(const exception &e) {
+        t = e.what();
+    }
+    CHECK_EQUAL("Wrong or missing filename.", t);
+};
+
+TEST(slightcsv, load_data_mmap_ok) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    vector<string> vect;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setReadMode(SlightCSV::READ_MODE_MMAP);
+        t = scsv.loadData();
+        scsv.getColumn(vect, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    CHECK_EQUAL("0.1", vect.at(8633));
+    CHECK_EQUAL("0", vect.at(8640));
+};
+
+TEST(slightcsv, complex_mmap) {
+    SlightCSV scsv;
+    string ex = "";
+    string file = "../../test/utf8_test_bom.csv";
+    set<string> stripset;
+    stripset.insert("Z");
+    map<string, string> repmap;
+    repmap.insert(pair<string, string>("¥", "$"));
+    string cell1;
+    string cell2;
+    string cell3;
+    try {
+        scsv.setFileName(file);
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        scsv.setStripChars(stripset);
+        scsv.setReplaceChars(repmap);
+        scsv.setReadMode(SlightCSV::READ_MODE_MMAP);
+        scsv.loadData();
+        scsv.getCell(cell1, 0, 0);
+        scsv.getCell(cell2, 2, 2);
+        scsv.getCell(cell3, 2, 5);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL("date", cell1);
+    CHECK_EQUAL("\"jack@smith.jp;jack1.smith@jp\"", cell2);
+    CHECK_EQUAL("$", cell3);
+};
+
+TEST(slightcsv, buffer_size_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(1024 * 1024, scsv.getBufferSize());
+};
+
+TEST(slightcsv, buffer_size_zero_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setBufferSize(0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Buffer size invalid.", ex);
+};
+
+TEST(slightcsv, buffer_size_reset) {
+    SlightCSV scsv;
+    scsv.setBufferSize(16);
+    CHECK_EQUAL(16, scsv.getBufferSize());
+    scsv.reset();
+    CHECK_EQUAL(1024 * 1024, scsv.getBufferSize());
+};
+
+TEST(slightcsv, load_data_small_buffer_ok) {
+    SlightCSV scsv;
+    size_t t = 0;
+    try {
+        scsv.setFileName("../../test/env_data_short.csv");
+        scsv.setSeparator(";");
+        scsv.setBufferSize(7);
+        t = scsv.loadData();
+    } catch(const exception &e) {
+    }
+    CHECK_EQUAL(865, t);
+};
+
+TEST(slightcsv, load_data_buffer_boundaries) {
+    string ex = "";
+    // every buffer size splits a multi-byte character or an escaped new line somewhere
+    for (size_t buffer_size = 1; buffer_size <= 8; ++buffer_size) {
+        SlightCSV scsv;
+        string cell1;
+        string cell2;
+        string cell3;
+        try {
+            scsv.setFileName("../../test/escaped_nl.csv");
+            scsv.setSeparator(";");
+            scsv.setEscape("\"");
+            scsv.setBufferSize(buffer_size);
+            scsv.loadData();
+            scsv.getCell(cell1, 1, 1);
+            scsv.getCell(cell2, 1, 2);
+            scsv.getCell(cell3, 2, 1);
+        } catch(const exception &e) {
+            ex = e.what();
+        }
+        CHECK_EQUAL("", ex);
+        CHECK_EQUAL(3, scsv.getRowCount());
+        CHECK_EQUAL("\"Jürgen\nMüller\"", cell1);
+        CHECK_EQUAL("€5", cell2);
+        CHECK_EQUAL("\"a;b\"", cell3);
+    }
+};
+
+TEST(slightcsv, load_buffer_no_separator) {
+    SlightCSV scsv;
+    string ex = "";
+    const char data[] = "1;2\n3;4\n";
+    try {
+        scsv.loadData(data, sizeof(data) - 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Separator character invalid or missing.", ex);
+};
+
+TEST(slightcsv, load_buffer_null_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setSeparator(";");
+        scsv.loadData(0, 10);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Buffer size invalid.", ex);
+};
+
+TEST(slightcsv, load_buffer_ok) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    string cell;
+    // no terminating new line, escaped separator and new line
+    const char data[] = "name;value\r\n\"a;b\";1\r\n\"c\nd\";2";
+    try {
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        t = scsv.loadData(data, sizeof(data) - 1);
+        scsv.getCell(cell, 2, 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(3, t);
+    CHECK_EQUAL(2, scsv.getColumnCount());
+    CHECK_EQUAL("\"c\nd\"", cell);
+};
+
+TEST(slightcsv, load_buffer_partial) {
+    SlightCSV scsv;
+    size_t t = 0;
+    const char data[] = "1;2\n3;4\n5;6\n";
+    try {
+        scsv.setSeparator(";");
+        // only the first two rows are part of the buffer
+        t = scsv.loadData(data, 8);
+    } catch(const exception &e) {
+    }
+    CHECK_EQUAL(2, t);
+};
+
+class CountingRowHandler: public utils::SlightRowHandler {
+
+    public:
+        CountingRowHandler(void): m_row_count(0), m_header_count(0), m_last_row_id(0), m_cell_count(0) {}
+
+        void handleRow(const vector<string> &t_cells, const size_t t_row_id, const bool t_is_header) {
+            ++m_row_count;
+            m_last_row_id = t_row_id;
+            if (t_is_header) {
+                ++m_header_count;
+            }
+            m_cell_count = t_cells.size();
+        }
+
+        size_t m_row_count;
+        size_t m_header_count;
+        size_t m_last_row_id;
+        size_t m_cell_count;
+
+};
+
+TEST(slightcsv, row_handler_default) {
+    SlightCSV scsv;
+    CountingRowHandler handler;
+    CHECK_EQUAL((utils::SlightRowHandler*)0, scsv.getRowHandler());
+    scsv.setRowHandler(&handler);
+    CHECK_EQUAL(&handler, scsv.getRowHandler());
+    scsv.reset();
+    CHECK_EQUAL((utils::SlightRowHandler*)0, scsv.getRowHandler());
+};
+
+TEST(slightcsv, row_handler_stream_ok) {
+    SlightCSV scsv;
+    CountingRowHandler handler;
+    string ex = "";
+    size_t t = 0;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setRowHandler(&handler);
+        t = scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+    CHECK_EQUAL(8641, handler.m_row_count);
+    CHECK_EQUAL(1, handler.m_header_count);
+    CHECK_EQUAL(8640, handler.m_last_row_id);
+    CHECK_EQUAL(30, handler.m_cell_count);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    // rows are not stored in streaming mode
+    try {
+        scsv.getRowCount();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Data not loaded.", ex);
+};
+
+TEST(slightcsv, row_handler_stream_then_store) {
+    SlightCSV scsv;
+    CountingRowHandler handler;
+    string ex = "";
+    size_t t1 = 0;
+    size_t t2 = 0;
+    try {
+        scsv.setFileName("../../test/env_data_short.csv");
+        scsv.setSeparator(";");
+        scsv.setRowHandler(&handler);
+        t1 = scsv.loadData();
+        scsv.setRowHandler(0);
+        t2 = scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(865, t1);
+    CHECK_EQUAL(865, t2);
+    CHECK_EQUAL(865, scsv.getRowCount());
+};
+
+TEST(slightcsv, row_handler_cellcnt_ex) {
+    SlightCSV scsv;
+    CountingRowHandler handler;
+    string ex = "";
+    try {
+        scsv.setFileName("../../test/env_data_sli.csv");
+        scsv.setSeparator(";");
+        scsv.setRowHandler(&handler);
+        scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("CSV format error (cell count mismatch in row).", ex);
+    CHECK_EQUAL(2, handler.m_row_count);
+};
+
+TEST(slightcsv, cursor_not_open_ex) {
+    utils::SlightCursor cursor;
+    vector<string> row;
+    string ex = "";
+    try {
+        cursor.next(row);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Cursor not open or not positioned on a row.", ex);
+};
+
+TEST(slightcsv, cursor_wrong_filename_ex) {
+    SlightCSV scsv;
+    utils::SlightCursor cursor;
+    string ex = "";
+    try {
+        scsv.setFileName("abc.def");
+        scsv.setSeparator(";");
+        cursor.open(scsv);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Wrong or missing filename.", ex);
+};
+
+TEST(slightcsv, cursor_iterate_ok) {
+    SlightCSV scsv;
+    utils::SlightCursor cursor;
+    vector<string> row;
+    string ex = "";
+    size_t row_count = 0;
+    size_t header_count = 0;
+    size_t last_index = 0;
+    try {
+        scsv.setFileName("../../test/env_data_short.csv");
+        scsv.setSeparator(";");
+        scsv.setBufferSize(100);
+        cursor.open(scsv);
+        while (cursor.next(row)) {
+            CHECK_EQUAL(30, row.size());
+            CHECK_EQUAL(row_count, cursor.getRowIndex());
+            if (cursor.getIsHeader()) {
+                ++header_count;
+            }
+            last_index = cursor.getRowIndex();
+            ++row_count;
+        }
+        CHECK_EQUAL(false, cursor.next(row));
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(865, row_count);
+    CHECK_EQUAL(1, header_count);
+    CHECK_EQUAL(864, last_index);
+    // the SlightCSV object used for settings is not loaded
+    try {
+        scsv.getRowCount();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Data not loaded.", ex);
+};
+
+TEST(slightcsv, cursor_escaped_row) {
+    SlightCSV scsv;
+    utils::SlightCursor cursor;
+    vector<string> row;
+    string ex = "";
+    try {
+        scsv.setFileName("../../test/escaped_nl.csv");
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        cursor.open(scsv);
+        cursor.next(row);
+        cursor.next(row);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(1, cursor.getRowIndex());
+    CHECK_EQUAL("\"Jürgen\nMüller\"", row.at(1));
+    cursor.close();
+    try {
+        cursor.getRowIndex();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Cursor not open or not positioned on a row.", ex);
+};
+
+TEST(slightcsv, buffer_count_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(2, scsv.getBufferCount());
+    CHECK_EQUAL(0, scsv.getStallTime());
+};
+
+TEST(slightcsv, buffer_count_too_low_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setBufferCount(1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Buffer size invalid.", ex);
+};
+
+TEST(slightcsv, load_data_read_ahead_ok) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    vector<string> vect;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setReadMode(SlightCSV::READ_MODE_READ_AHEAD);
+        scsv.setBufferSize(4096);
+        scsv.setBufferCount(4);
+        t = scsv.loadData();
+        scsv.getColumn(vect, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+    CHECK_EQUAL("0.1", vect.at(8633));
+    CHECK_EQUAL(true, scsv.getStallTime() >= 0);
+};
+
+TEST(slightcsv, load_data_read_ahead_boundaries) {
+    string ex = "";
+    for (size_t buffer_size = 1; buffer_size <= 4; ++buffer_size) {
+        SlightCSV scsv;
+        string cell;
+        try {
+            scsv.setFileName("../../test/escaped_nl.csv");
+            scsv.setSeparator(";");
+            scsv.setEscape("\"");
+            scsv.setReadMode(SlightCSV::READ_MODE_READ_AHEAD);
+            scsv.setBufferSize(buffer_size);
+            scsv.loadData();
+            scsv.getCell(cell, 1, 1);
+        } catch(const exception &e) {
+            ex = e.what();
+        }
+        CHECK_EQUAL("", ex);
+        CHECK_EQUAL("\"Jürgen\nMüller\"", cell);
+    }
+};
+
+TEST(slightcsv, load_data_read_ahead_format_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setFileName("../../test/env_data_sli.csv");
+        scsv.setSeparator(";");
+        scsv.setReadMode(SlightCSV::READ_MODE_READ_AHEAD);
+        scsv.setBufferSize(16);
+        scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    // the I/O thread is stopped cleanly when parsing fails
+    CHECK_EQUAL("CSV format error (cell count mismatch in row).", ex);
+};
+
+TEST(slightcsv, load_data_io_uring_ok) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    vector<string> vect;
+    // falls back to stream reading if io_uring is not available
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setReadMode(SlightCSV::READ_MODE_IO_URING);
+        scsv.setBufferSize(4096);
+        scsv.setBufferCount(8);
+        t = scsv.loadData();
+        scsv.getColumn(vect, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+    CHECK_EQUAL("0.1", vect.at(8633));
+};
+
+TEST(slightcsv, load_data_io_uring_wrong_filename) {
+    SlightCSV scsv;
+    string t = "";
+    try {
+        scsv.setFileName("abc.def");
+        scsv.setSeparator(";");
+        scsv.setReadMode(SlightCSV::READ_MODE_IO_URING);
+        scsv.loadData();
+    } catch(const exception &e) {
+        t = e.what();
+    }
+    CHECK_EQUAL("Wrong or missing filename.", t);
+};
+
+TEST(slightcsv, load_data_gzip_ok) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    vector<string> vect;
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_GZIP)) {
+        return;
+    }
+    try {
+        scsv.setFileName("../../test/env_data.csv.gz");
+        scsv.setSeparator(";");
+        scsv.setBufferSize(4096);
+        t = scsv.loadData();
+        scsv.getColumn(vect, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+    CHECK_EQUAL("0.1", vect.at(8633));
+    CHECK_EQUAL(true, scsv.getStallTime() >= 0);
+};
+
+TEST(slightcsv, load_data_gzip_mmap_boundaries) {
+    string ex = "";
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_GZIP)) {
+        return;
+    }
+    for (size_t buffer_size = 1; buffer_size <= 4; ++buffer_size) {
+        SlightCSV scsv;
+        string cell;
+        try {
+            scsv.setFileName("../../test/escaped_nl.csv.gz");
+            scsv.setSeparator(";");
+            scsv.setEscape("\"");
+            scsv.setReadMode(SlightCSV::READ_MODE_MMAP);
+            scsv.setBufferSize(buffer_size);
+            scsv.loadData();
+            scsv.getCell(cell, 1, 1);
+        } catch(const exception &e) {
+            ex = e.what();
+        }
+        CHECK_EQUAL("", ex);
+        CHECK_EQUAL("\"Jürgen\nMüller\"", cell);
+    }
+};
+
+TEST(slightcsv, load_data_gzip_truncated_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_GZIP)) {
+        return;
+    }
+    try {
+        scsv.setFileName("../../test/escaped_nl_trunc.csv.gz");
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Unexpected error occurred while reading file.", ex);
+};
+
+TEST(slightcsv, load_data_zstd) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    try {
+        scsv.setFileName("../../test/escaped_nl.csv.zst");
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        t = scsv.loadData();
+        scsv.getCell(cell, 2, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_ZSTD)) {
+        CHECK_EQUAL("Compression format not supported.", ex);
+        return;
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(3, t);
+    CHECK_EQUAL("\"a;b\"", cell);
+};
+
+TEST(slightcsv, cursor_gzip) {
+    SlightCSV scsv;
+    utils::SlightCursor cursor;
+    vector<string> row;
+    string ex = "";
+    size_t count = 0;
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_GZIP)) {
+        return;
+    }
+    try {
+        scsv.setFileName("../../test/env_data.csv.gz");
+        scsv.setSeparator(";");
+        cursor.open(scsv);
+        while (cursor.next(row)) {
+            ++count;
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, count);
+};
+
+// write (or append to) a file used by the incremental reload tests
+static void writeFile(const char *t_filename, const char *t_mode, const char *t_contents) {
+    FILE *f = fopen(t_filename, t_mode);
+    fputs(t_contents, f);
+    fclose(f);
+}
+
+TEST(slightcsv, reload_data_appended) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    size_t t_none = 1;
+    writeFile("reload_tmp.csv", "wb", "id;value\n1;a\n");
+    try {
+        scsv.setFileName("reload_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.loadData();
+        writeFile("reload_tmp.csv", "ab", "2;b\n3;c\n");
+        t = scsv.reloadData();
+        t_none = scsv.reloadData();
+        scsv.getCell(cell, 3, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("reload_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(2, t);
+    CHECK_EQUAL(0, t_none);
+    CHECK_EQUAL(4, scsv.getRowCount());
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    CHECK_EQUAL("c", cell);
+};
+
+TEST(slightcsv, reload_data_unterminated_row) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    writeFile("reload_tmp.csv", "wb", "id;note\n1;\"x");
+    try {
+        scsv.setFileName("reload_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        scsv.loadData();
+        // the escaped new line continues the last row
+        writeFile("reload_tmp.csv", "ab", "\ny\"\n2;z\n");
+        t = scsv.reloadData();
+        scsv.getCell(cell, 1, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("reload_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(2, t);
+    CHECK_EQUAL(3, scsv.getRowCount());
+    CHECK_EQUAL("\"x\ny\"", cell);
+};
+
+TEST(slightcsv, reload_data_truncated) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    writeFile("reload_tmp.csv", "wb", "id;value\n1;a\n2;b\n3;c\n");
+    try {
+        scsv.setFileName("reload_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.loadData();
+        writeFile("reload_tmp.csv", "wb", "id;value\n4;d\n");
+        t = scsv.reloadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("reload_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(2, t);
+    CHECK_EQUAL(2, scsv.getRowCount());
+};
+
+TEST(slightcsv, reload_data_rotated) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    writeFile("reload_tmp.csv", "wb", "id;value\n1;a\n");
+    try {
+        scsv.setFileName("reload_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.loadData();
+        // replaced by a longer file
+        remove("reload_tmp.csv");
+        writeFile("reload_tmp.csv", "wb", "id;other\n5;e\n6;f\n");
+        t = scsv.reloadData();
+        scsv.getCell(cell, 0, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("reload_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(3, t);
+    CHECK_EQUAL("other", cell);
+};
+
+TEST(slightcsv, reload_data_not_loaded) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        t = scsv.reloadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+};
+
+TEST(slightcsv, reload_data_streaming) {
+    SlightCSV scsv;
+    CountingRowHandler handler;
+    string ex = "";
+    size_t t = 0;
+    writeFile("reload_tmp.csv", "wb", "id;value\n1;a\n");
+    try {
+        scsv.setFileName("reload_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.setRowHandler(&handler);
+        scsv.loadData();
+        writeFile("reload_tmp.csv", "ab", "2;b\n");
+        t = scsv.reloadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("reload_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(1, t);
+    CHECK_EQUAL(3, handler.m_row_count);
+};
+
+TEST(slightcsv, load_data_range_shards) {
+    string ex = "";
+    size_t file_size = 0;
+    FILE *f = fopen("../../test/env_data.csv", "rb");
+    fseek(f, 0L, SEEK_END);
+    file_size = ftell(f);
+    fclose(f);
+    for (size_t shard_count = 1; shard_count <= 7; ++shard_count) {
+        size_t data_row_count = 0;
+        string first_cell;
+        string last_cell;
+        for (size_t shard = 0; shard < shard_count; ++shard) {
+            SlightCSV scsv;
+            size_t offset = file_size * shard / shard_count;
+            size_t length = file_size * (shard + 1) / shard_count - offset;
+            try {
+                scsv.setFileName("../../test/env_data.csv");
+                scsv.setSeparator(";");
+                scsv.loadDataRange(offset, length);
+                data_row_count += scsv.getRowCount() - scsv.getHeaderCount();
+                if (!shard) {
+                    scsv.getCell(first_cell, 1, 1);
+                }
+                if (shard == shard_count - 1) {
+                    scsv.getCell(last_cell, scsv.getRowCount() - 1, 0);
+                }
+            } catch(const exception &e) {
+                ex = e.what();
+            }
+            // header row is loaded for every shard
+            CHECK_EQUAL(1, scsv.getHeaderCount());
+        }
+        CHECK_EQUAL("", ex);
+        CHECK_EQUAL(8640, data_row_count);
+        CHECK_EQUAL("0", first_cell);
+        CHECK_EQUAL("10", last_cell);
+    }
+};
+
+TEST(slightcsv, load_data_range_escaped) {
+    string ex = "";
+    // split the file at every byte, rows with escaped new lines are loaded by exactly one of the shards
+    for (size_t offset = 1; offset < 60; ++offset) {
+        SlightCSV first;
+        SlightCSV second;
+        vector<string> ids;
+        vector<string> names;
+        try {
+            first.setFileName("../../test/escaped_nl_data.csv");
+            first.setSeparator(";");
+            first.setEscape("\"");
+            second.setFileName("../../test/escaped_nl_data.csv");
+            second.setSeparator(";");
+            second.setEscape("\"");
+            first.loadDataRange(0, offset);
+            second.loadDataRange(offset, 1000);
+            vector<string> column;
+            if (first.getRowCount() > first.getHeaderCount()) {
+                first.getColumn(ids, 0, 1);
+                first.getColumn(names, 1, 1);
+            }
+            if (second.getRowCount() > second.getHeaderCount()) {
+                second.getColumn(column, 0, 1);
+                ids.insert(ids.end(), column.begin(), column.end());
+                second.getColumn(column, 1, 1);
+                names.insert(names.end(), column.begin(), column.end());
+            }
+        } catch(const exception &e) {
+            ex = e.what();
+        }
+        CHECK_EQUAL("", ex);
+        CHECK_EQUAL(4, ids.size());
+        CHECK_EQUAL("1", ids.at(0));
+        CHECK_EQUAL("4", ids.at(3));
+        CHECK_EQUAL("\"e\r\nf\ng\"", names.at(2));
+    }
+};
+
+TEST(slightcsv, load_data_range_bom_empty_line) {
+    string ex = "";
+    bool shards_ok = true;
+    // the first row begins after the BOM and an empty line
+    writeFile("range_tmp.csv", "wb", "\xef\xbb\xbf\n-3\n5\n-3");
+    for (size_t offset = 1; offset < 11; ++offset) {
+        SlightCSV first;
+        SlightCSV second;
+        string cells;
+        try {
+            first.setFileName("range_tmp.csv");
+            first.setSeparator(";");
+            first.setHeaderMode(SlightCSV::HEADER_MODE_NONE);
+            second.setFileName("range_tmp.csv");
+            second.setSeparator(";");
+            second.setHeaderMode(SlightCSV::HEADER_MODE_NONE);
+            size_t first_count = first.loadDataRange(0, offset);
+            size_t second_count = second.loadDataRange(offset, 100);
+            string cell;
+            for (size_t i = 0; i < first_count; ++i) {
+                first.getCell(cell, i, 0);
+                cells += cell + ",";
+            }
+            for (size_t i = 0; i < second_count; ++i) {
+                second.getCell(cell, i, 0);
+                cells += cell + ",";
+            }
+        } catch(const exception &e) {
+            ex = e.what();
+        }
+        shards_ok = shards_ok && cells == "-3,5,-3,";
+    }
+    remove("range_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(true, shards_ok);
+};
+
+TEST(slightcsv, load_data_range_zero_length_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.loadDataRange(100, 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Byte range invalid.", ex);
+};
+
+TEST(slightcsv, load_data_range_compressed_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setFileName("../../test/env_data.csv.gz");
+        scsv.setSeparator(";");
+        scsv.loadDataRange(0, 100);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Compression format not supported.", ex);
+};
+
+TEST(slightcsv, row_skip_limit_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(0, scsv.getRowSkip());
+    CHECK_EQUAL(0, scsv.getRowLimit());
+    scsv.setRowSkip(3);
+    scsv.setRowLimit(5);
+    CHECK_EQUAL(3, scsv.getRowSkip());
+    CHECK_EQUAL(5, scsv.getRowLimit());
+    scsv.reset();
+    CHECK_EQUAL(0, scsv.getRowSkip());
+    CHECK_EQUAL(0, scsv.getRowLimit());
+};
+
+TEST(slightcsv, load_data_row_limit) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    string cell;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setRowLimit(10);
+        t = scsv.loadData();
+        scsv.getCell(cell, 10, 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    // header row and the limited number of data rows
+    CHECK_EQUAL(11, t);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+};
+
+TEST(slightcsv, load_data_row_skip_limit) {
+    SlightCSV scsv;
+    SlightCSV reference;
+    string ex = "";
+    size_t t = 0;
+    vector<string> row;
+    vector<string> reference_row;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setRowSkip(5);
+        scsv.setRowLimit(3);
+        t = scsv.loadData();
+        scsv.getRow(row, 1);
+        reference.setFileName("../../test/env_data.csv");
+        reference.setSeparator(";");
+        reference.loadData();
+        reference.getRow(reference_row, 6);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(4, t);
+    CHECK_EQUAL(true, row == reference_row);
+};
+
+TEST(slightcsv, load_data_row_limit_stops_early) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    // the malformed row after the limit is not read
+    try {
+        scsv.setFileName("../../test/env_data_sli.csv");
+        scsv.setSeparator(";");
+        scsv.setRowLimit(1);
+        t = scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(1, t);
+};
+
+TEST(slightcsv, cursor_row_skip_limit) {
+    SlightCSV scsv;
+    utils::SlightCursor cursor;
+    vector<string> row;
+    string ex = "";
+    size_t count = 0;
+    size_t first_data_row_index = 0;
+    try {
+        scsv.setFileName("../../test/env_data.csv");
+        scsv.setSeparator(";");
+        scsv.setRowSkip(100);
+        scsv.setRowLimit(20);
+        cursor.open(scsv);
+        while (cursor.next(row)) {
+            if (count == 1) {
+                first_data_row_index = cursor.getRowIndex();
+            }
+            ++count;
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(21, count);
+    CHECK_EQUAL(101, first_data_row_index);
+};
+
+TEST(slightcsv, thread_count_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(0, scsv.getThreadCount());
+    scsv.setThreadCount(3);
+    CHECK_EQUAL(3, scsv.getThreadCount());
+};
+
+TEST(slightcsv, load_data_files) {
+    SlightCSV scsv;
+    SlightCSV reference;
+    vector<string> filenames;
+    vector<string> row;
+    vector<string> reference_row;
+    vector<string> header;
+    string ex = "";
+    size_t t = 0;
+    filenames.push_back("../../test/env_data.csv");
+    filenames.push_back("../../test/env_data_short.csv");
+    filenames.push_back("../../test/env_data.csv");
+    try {
+        scsv.setSeparator(";");
+        scsv.setThreadCount(2);
+        t = scsv.loadData(filenames);
+        scsv.getRow(header, 0);
+        scsv.getRow(row, 8641);
+        reference.setFileName("../../test/env_data_short.csv");
+        reference.setSeparator(";");
+        reference.loadData();
+        reference.getRow(reference_row, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    // header rows are kept from the first file only, the order of the files is kept
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641 + 864 + 8640, t);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    CHECK_EQUAL("tst", header[0]);
+    CHECK_EQUAL(true, row == reference_row);
+};
+
+TEST(slightcsv, load_data_files_cell_count_ex) {
+    SlightCSV scsv;
+    vector<string> filenames;
+    string ex = "";
+    filenames.push_back("../../test/env_data.csv");
+    filenames.push_back("../../test/escaped_nl_data.csv");
+    try {
+        scsv.setSeparator(";");
+        scsv.loadData(filenames);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("CSV format error (cell count mismatch in row).", ex);
+};
+
+TEST(slightcsv, load_data_files_filename_ex) {
+    SlightCSV scsv;
+    vector<string> filenames;
+    string ex = "";
+    try {
+        scsv.setSeparator(";");
+        scsv.loadData(filenames);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Wrong or missing filename.", ex);
+    ex = "";
+    filenames.push_back("../../test/env_data.csv");
+    filenames.push_back("../../test/missing.csv");
+    try {
+        scsv.loadData(filenames);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Wrong or missing filename.", ex);
+};
+
+TEST(slightcsv, load_data_glob) {
+    SlightCSV scsv;
+    vector<string> row;
+    string ex = "";
+    size_t t = 0;
+    try {
+        scsv.setSeparator(";");
+        t = scsv.loadDataGlob("../../test/env_data_[0].csv");
+        scsv.getRow(row, 9);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(10, t);
+    CHECK_EQUAL("9", row[0]);
+    // the matching files have different header counts
+    ex = "";
+    try {
+        scsv.loadDataGlob("../../test/env_data_[02].csv");
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("CSV format error (intermediate header).", ex);
+    ex = "";
+    try {
+        scsv.loadDataGlob("../../test/no_such_file*.csv");
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Wrong or missing filename.", ex);
+};
+
+TEST(slightcsv, load_data_files_streaming) {
+    SlightCSV scsv;
+    CountingRowHandler handler;
+    vector<string> filenames;
+    string ex = "";
+    size_t t = 0;
+    filenames.push_back("../../test/env_data_short.csv");
+    filenames.push_back("../../test/env_data.csv");
+    try {
+        scsv.setSeparator(";");
+        scsv.setRowHandler(&handler);
+        t = scsv.loadData(filenames);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(865 + 8640, t);
+    CHECK_EQUAL(865 + 8640, handler.m_row_count);
+    CHECK_EQUAL(1, handler.m_header_count);
+    CHECK_EQUAL(865 + 8640 - 1, handler.m_last_row_id);
+};
+
+// row handler collecting the first cells of the data rows
+class FirstCellRowHandler: public utils::SlightRowHandler {
+
+    public:
+        void handleRow(const vector<string> &t_cells, const size_t t_row_id, const bool t_is_header) {
+            (void)t_row_id;
+            if (!t_is_header) {
+                m_first_cells += t_cells[0] + ",";
+            }
+        }
+
+        string m_first_cells;
+
+};
+
+// get the first cells of the data rows of the files loaded with the given skip and limit (pooled or streaming)
+static string loadFilesFirstCells(const vector<string> &t_filenames, const size_t t_skip, const size_t t_limit, 
+    const bool t_is_streaming) {
+    SlightCSV scsv;
+    FirstCellRowHandler handler;
+    scsv.setSeparator(";");
+    scsv.setRowSkip(t_skip);
+    scsv.setRowLimit(t_limit);
+    if (t_is_streaming) {
+        scsv.setRowHandler(&handler);
+        scsv.loadData(t_filenames);
+        return handler.m_first_cells;
+    }
+    scsv.loadData(t_filenames);
+    string first_cells;
+    for (size_t i = scsv.getHeaderCount(); i < scsv.getRowCount(); ++i) {
+        string cell;
+        scsv.getCell(cell, i, 0);
+        first_cells += cell + ",";
+    }
+    return first_cells;
+}
+
+TEST(slightcsv, load_data_files_skip_limit) {
+    vector<string> filenames;
+    string ex = "";
+    vector<string> pooled;
+    vector<string> streamed;
+    writeFile("files_1_tmp.csv", "wb", "id;value\n1;2\n3;4\n5;6\n");
+    writeFile("files_2_tmp.csv", "wb", "id;value\n7;8\n9;10\n11;12\n");
+    filenames.push_back("files_1_tmp.csv");
+    filenames.push_back("files_2_tmp.csv");
+    // no more files are read once the limit is reached
+    filenames.push_back("files_missing_tmp.csv");
+    try {
+        for (int mode = 0; mode < 2; ++mode) {
+            vector<string> &results = mode ? streamed : pooled;
+            results.push_back(loadFilesFirstCells(filenames, 0, 2, mode != 0));
+            results.push_back(loadFilesFirstCells(filenames, 2, 3, mode != 0));
+            results.push_back(loadFilesFirstCells(filenames, 4, 1, mode != 0));
+            results.push_back(loadFilesFirstCells(filenames, 3, 3, mode != 0));
+            filenames.pop_back();
+            results.push_back(loadFilesFirstCells(filenames, 1, 0, mode != 0));
+            filenames.push_back("files_missing_tmp.csv");
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("files_1_tmp.csv");
+    remove("files_2_tmp.csv");
+    CHECK_EQUAL("", ex);
+    for (int mode = 0; mode < 2; ++mode) {
+        vector<string> &results = mode ? streamed : pooled;
+        CHECK_EQUAL(5, results.size());
+        CHECK_EQUAL("1,3,", results[0]);
+        CHECK_EQUAL("5,7,9,", results[1]);
+        CHECK_EQUAL("9,", results[2]);
+        CHECK_EQUAL("7,9,11,", results[3]);
+        CHECK_EQUAL("3,5,7,9,11,", results[4]);
+    }
+};
+
+TEST(slightcsv, load_data_stdio_stream) {
+    SlightCSV scsv;
+    SlightCSV reference;
+    vector<string> row;
+    vector<string> reference_row;
+    string ex = "";
+    size_t t = 0;
+    FILE *f = fopen("../../test/escaped_nl_data.csv", "rb");
+    try {
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        t = scsv.loadData(f);
+        scsv.getRow(row, 3);
+        reference.setFileName("../../test/escaped_nl_data.csv");
+        reference.setSeparator(";");
+        reference.setEscape("\"");
+        reference.loadData();
+        reference.getRow(reference_row, 3);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    fclose(f);
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(5, t);
+    CHECK_EQUAL(true, row == reference_row);
+};
+
+TEST(slightcsv, load_data_pipe) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    // the input arrives in small blocks, the data structure grows from the size of the first one
+    FILE *f = popen("cat ../../test/env_data.csv", "r");
+    try {
+        scsv.setSeparator(";");
+        scsv.setBufferSize(4096);
+        t = scsv.loadData(fileno(f));
+        scsv.getCell(cell, 8640, 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    pclose(f);
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(8641, t);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    CHECK_EQUAL("10", cell);
+};
+
+TEST(slightcsv, load_data_istream) {
+    SlightCSV scsv;
+    std::istringstream stream("id;value\n1;\"a\nb\"\n2;c\n");
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    try {
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        t = scsv.loadData(stream);
+        scsv.getCell(cell, 1, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(3, t);
+    CHECK_EQUAL("\"a\nb\"", cell);
+};
+
+TEST(slightcsv, load_data_stream_ex) {
+    SlightCSV scsv;
+    string ex = "";
+    try {
+        scsv.setSeparator(";");
+        scsv.loadData((FILE*)0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Input stream invalid.", ex);
+    ex = "";
+    try {
+        scsv.loadData(-1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Input stream invalid.", ex);
+};
+
+TEST(slightcsv, load_data_fifo) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    remove("fifo_tmp.csv");
+    CHECK_EQUAL(0, mkfifo("fifo_tmp.csv", 0600));
+    // the writer blocks until the FIFO is opened for reading
+    FILE *f = popen("cat ../../test/escaped_nl_data.csv > fifo_tmp.csv", "r");
+    try {
+        scsv.setFileName("fifo_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        t = scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    pclose(f);
+    remove("fifo_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(5, t);
+};
+
+TEST(slightcsv, load_buffer_replaced_separator) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t t = 0;
+    vector<string> row;
+    map<string, string> rep_chars;
+    // replacements are applied before splitting the row into cells
+    rep_chars["|"] = ";";
+    const char data[] = "name|value;id\n\"a|b\"|1;2\n;3|\n";
+    try {
+        scsv.setSeparator(";");
+        scsv.setEscape("\"");
+        scsv.setReplaceChars(rep_chars);
+        t = scsv.loadData(data, sizeof(data) - 1);
+        scsv.getRow(row, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(3, t);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    CHECK_EQUAL("\"a;b\"", row[0]);
+    CHECK_EQUAL("1", row[1]);
+    CHECK_EQUAL("2", row[2]);
+    scsv.getRow(row, 2);
+    CHECK_EQUAL("", row[0]);
+    CHECK_EQUAL("3", row[1]);
+    CHECK_EQUAL("", row[2]);
+};
+
+// load a buffer and return its rows (cells separated by new lines)
+static string loadBufferRows(const string &t_data, const char *t_separator, const char *t_escape) {
+    SlightCSV scsv;
+    vector<string> row;
+    string rows;
+    scsv.setSeparator(t_separator);
+    if (t_escape) {
+        scsv.setEscape(t_escape);
+    }
+    // small buffers split rows and cells between chunks
+    scsv.setBufferSize(7);
+    size_t t = scsv.loadData(t_data.data(), t_data.size());
+    for (size_t i = 0; i < t; ++i) {
+        scsv.getRow(row, i);
+        for (size_t j = 0; j < row.size(); ++j) {
+            rows += row[j] + "\n";
+        }
+    }
+    return rows;
+}
+
+TEST(slightcsv, load_buffer_dialects) {
+    string ex = "";
+    string specialized;
+    string generic;
+    string tab_specialized;
+    string tab_generic;
+    // long and short cells, escaped separators and new lines, empty cells, NUL bytes and multibyte characters
+    string data = "id,name,value\r\n1,\"a,\r\nb\",2\n\n3,,\n12345678901234567890,x\xc3\xa9y,4\n";
+    data += string("5,6\0", 5) + "7,\"8\"\"9\"\n";
+    string generic_data = data;
+    std::replace(generic_data.begin(), generic_data.end(), ',', '|');
+    string tab_data = "id\tname\tvalue\r\n1\t\t2\n\n12345678901234567890\tx\xc3\xa9y\t\n";
+    tab_data += string("5\t6\0", 5) + "7\t\"8\"\n";
+    string tab_generic_data = tab_data;
+    std::replace(tab_generic_data.begin(), tab_generic_data.end(), '\t', '|');
+    try {
+        specialized = loadBufferRows(data, ",", "\"");
+        generic = loadBufferRows(generic_data, "|", "\"");
+        tab_specialized = loadBufferRows(tab_data, "\t", 0);
+        tab_generic = loadBufferRows(tab_generic_data, "|", 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    std::replace(generic.begin(), generic.end(), '|', ',');
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(generic, specialized);
+    CHECK_EQUAL(tab_generic, tab_specialized);
+    CHECK_EQUAL("id\nname\nvalue\n1\n\"a,\r\nb\"\n2\n3\n\n\n12345678901234567890\nx\xc3\xa9y\n4\n"
+        "5\n67\n\"8\"\"9\"\n", specialized);
+};
+
+TEST(slightcsv, load_buffer_multibyte_strip_replace) {
+    SlightCSV scsv;
+    string ex = "";
+    vector<string> row;
+    set<string> strip_chars;
+    map<string, string> rep_chars;
+    strip_chars.insert("\xc2\xa0");
+    rep_chars["\xe2\x80\x9c"] = "\"";
+    rep_chars["\xc3\xa9"] = "e";
+    // non-breaking spaces stripped off, typographic quotes and accents replaced
+    const char data[] = "caf\xc3\xa9;\xc2\xa0prix\n\xe2\x80\x9c\x31\xc2\xa0\x32\xe2\x80\x9c;3\xe2\x82\xac\n";
+    try {
+        scsv.setSeparator(";");
+        scsv.setStripChars(strip_chars);
+        scsv.setReplaceChars(rep_chars);
+        scsv.loadData(data, sizeof(data) - 1);
+        scsv.getRow(row, 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL("cafe", row[0]);
+    CHECK_EQUAL("prix", row[1]);
+    scsv.getRow(row, 1);
+    CHECK_EQUAL("\"12\"", row[0]);
+    CHECK_EQUAL("3\xe2\x82\xac", row[1]);
+};
+
+TEST(slightcsv, chunk_size) {
+    SlightCSV scsv;
+    string ex = "";
+    CHECK_EQUAL(16 * 1024 * 1024, scsv.getChunkSize());
+    scsv.setChunkSize(4096);
+    CHECK_EQUAL(4096, scsv.getChunkSize());
+    try {
+        scsv.setChunkSize(0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Buffer size invalid.", ex);
+};
+
+// load a file on one thread and in small chunks on multiple threads, the results must be the same
+static bool loadParallelMatches(const char *t_filename, const char *t_escape) {
+    SlightCSV reference;
+    SlightCSV scsv;
+    vector<string> reference_row;
+    vector<string> row;
+    reference.setFileName(t_filename);
+    reference.setSeparator(";");
+    reference.setThreadCount(1);
+    scsv.setFileName(t_filename);
+    scsv.setSeparator(";");
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(50);
+    scsv.setBufferSize(16);
+    if (t_escape) {
+        reference.setEscape(t_escape);
+        scsv.setEscape(t_escape);
+    }
+    size_t t = scsv.loadData();
+    if (t != reference.loadData() || scsv.getHeaderCount() != reference.getHeaderCount() || 
+        scsv.getColumnCount() != reference.getColumnCount()) {
+        return false;
+    }
+    for (size_t i = 0; i < t; ++i) {
+        reference.getRow(reference_row, i);
+        scsv.getRow(row, i);
+        if (row != reference_row) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(slightcsv, load_data_parallel) {
+    string ex = "";
+    string contents = "id;name;value\n";
+    string quoted_contents = "id;name;value\n";
+    for (int i = 0; i < 300; ++i) {
+        // escaped regions spanning chunk boundaries, escaped separators and new lines
+        contents += "1;\"2\n3;" + string(i % 70, '4') + "\";" + (i % 3 ? "5\r\n" : "5\n\n");
+        // multibyte characters at chunk boundaries
+        quoted_contents += "1;\"\xc3\xa9\n\xc3\xa9;\";2" + string(i % 40, '3') + "\xc3\xa9\n";
+    }
+    writeFile("parallel_tmp.csv", "wb", contents.c_str());
+    writeFile("parallel_utf8_tmp.csv", "wb", quoted_contents.c_str());
+    bool env_data_ok = false;
+    bool escaped_ok = false;
+    bool bom_ok = false;
+    bool tmp_ok = false;
+    bool utf8_tmp_ok = false;
+    try {
+        env_data_ok = loadParallelMatches("../../test/env_data.csv", 0);
+        escaped_ok = loadParallelMatches("../../test/escaped_nl_data.csv", "\"");
+        bom_ok = loadParallelMatches("../../test/utf8_test_bom.csv", "\"");
+        tmp_ok = loadParallelMatches("parallel_tmp.csv", "\"");
+        utf8_tmp_ok = loadParallelMatches("parallel_utf8_tmp.csv", "\"");
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    remove("parallel_utf8_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(true, env_data_ok);
+    CHECK_EQUAL(true, escaped_ok);
+    CHECK_EQUAL(true, bom_ok);
+    CHECK_EQUAL(true, tmp_ok);
+    CHECK_EQUAL(true, utf8_tmp_ok);
+};
+
+TEST(slightcsv, load_data_parallel_empty_lines) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    string contents = "id;value\r\n";
+    set<string> strip_chars;
+    strip_chars.insert("x");
+    for (int i = 0; i < 200; ++i) {
+        // lines of stripped characters only are in the row index, but they are not rows
+        contents += i % 7 ? "1;2\r\n" : "xx\r\n\n1;2\n";
+    }
+    contents += "3;4";
+    writeFile("parallel_tmp.csv", "wb", contents.c_str());
+    scsv.setFileName("parallel_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setStripChars(strip_chars);
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(64);
+    size_t t = 0;
+    try {
+        t = scsv.loadData();
+        scsv.getCell(cell, 201, 0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(202, t);
+    CHECK_EQUAL(1, scsv.getHeaderCount());
+    CHECK_EQUAL("3", cell);
+};
+
+TEST(slightcsv, load_data_parallel_reload) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t t = 0;
+    string contents = "id;value\n";
+    for (int i = 0; i < 100; ++i) {
+        contents += "1;abcdefghij\n";
+    }
+    writeFile("parallel_tmp.csv", "wb", contents.c_str());
+    try {
+        scsv.setFileName("parallel_tmp.csv");
+        scsv.setSeparator(";");
+        scsv.setThreadCount(3);
+        scsv.setChunkSize(100);
+        scsv.loadData();
+        // rows appended after a parallel load are loaded incrementally
+        writeFile("parallel_tmp.csv", "ab", "2;z\n");
+        t = scsv.reloadData();
+        scsv.getCell(cell, 101, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(1, t);
+    CHECK_EQUAL(102, scsv.getRowCount());
+    CHECK_EQUAL("z", cell);
+};
+
+TEST(slightcsv, load_data_parallel_ex) {
+    SlightCSV scsv;
+    string header_ex = "";
+    string cell_count_ex = "";
+    string contents = "id;value\n";
+    for (int i = 0; i < 100; ++i) {
+        contents += "1;2\n";
+    }
+    // header row in a later chunk
+    writeFile("parallel_tmp.csv", "wb", (contents + "id;value\n").c_str());
+    scsv.setFileName("parallel_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(64);
+    try {
+        scsv.loadData();
+    } catch(const exception &e) {
+        header_ex = e.what();
+    }
+    // different cell count in a later chunk (the rows before the error are kept by a failed load)
+    writeFile("parallel_tmp.csv", "wb", (contents + "1;2;3\n").c_str());
+    try {
+        scsv.unloadData();
+        scsv.loadData();
+    } catch(const exception &e) {
+        cell_count_ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    CHECK_EQUAL("CSV format error (intermediate header).", header_ex);
+    CHECK_EQUAL("CSV format error (cell count mismatch in row).", cell_count_ex);
+};
+
+TEST(slightcsv, load_data_parallel_ex_state) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell_count_ex = "";
+    string utf8_ex = "";
+    size_t cell_count_rows = 0;
+    size_t cell_count_headers = 0;
+    size_t utf8_rows = 0;
+    size_t utf8_count = 0;
+    string last_cell;
+    string contents = "id;name;value\n";
+    for (int i = 0; i < 1000; ++i) {
+        contents += i == 500 ? "1;2\n" : "1;2;3\n";
+    }
+    writeFile("parallel_tmp.csv", "wb", contents.c_str());
+    contents = "id;name;value\n";
+    for (int i = 0; i < 1000; ++i) {
+        contents += i == 600 ? "\xff;2;3\n" : "1;2;3\n";
+    }
+    writeFile("parallel_utf8_tmp.csv", "wb", contents.c_str());
+    scsv.setSeparator(";");
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(256);
+    // the rows before the error are kept, as by the sequential loading
+    try {
+        scsv.setFileName("parallel_tmp.csv");
+        scsv.loadData();
+    } catch(const exception &e) {
+        cell_count_ex = e.what();
+    }
+    try {
+        cell_count_rows = scsv.getRowCount();
+        cell_count_headers = scsv.getHeaderCount();
+        scsv.getCell(last_cell, cell_count_rows - 1, 2);
+        scsv.unloadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    try {
+        scsv.setFileName("parallel_utf8_tmp.csv");
+        scsv.loadData();
+    } catch(const exception &e) {
+        utf8_ex = e.what();
+    }
+    utf8_rows = scsv.getRowCount();
+    utf8_count = scsv.getUtf8ErrorCount();
+    remove("parallel_tmp.csv");
+    remove("parallel_utf8_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL("CSV format error (cell count mismatch in row).", cell_count_ex);
+    CHECK_EQUAL(501, cell_count_rows);
+    CHECK_EQUAL(1, cell_count_headers);
+    CHECK_EQUAL("3", last_cell);
+    CHECK_EQUAL("UTF-8 format error.", utf8_ex);
+    CHECK_EQUAL(601, utf8_rows);
+    CHECK_EQUAL(1, utf8_count);
+};
+
+TEST(slightcsv, header_mode_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(SlightCSV::HEADER_MODE_DETECT, scsv.getHeaderMode());
+    CHECK_EQUAL(0, scsv.getHeaderRowCount());
+    scsv.setHeaderMode(SlightCSV::HEADER_MODE_FIXED);
+    scsv.setHeaderRowCount(2);
+    CHECK_EQUAL(SlightCSV::HEADER_MODE_FIXED, scsv.getHeaderMode());
+    CHECK_EQUAL(2, scsv.getHeaderRowCount());
+    scsv.reset();
+    CHECK_EQUAL(SlightCSV::HEADER_MODE_DETECT, scsv.getHeaderMode());
+    CHECK_EQUAL(0, scsv.getHeaderRowCount());
+};
+
+TEST(slightcsv, load_data_header_modes) {
+    SlightCSV scsv;
+    string ex = "";
+    string cell;
+    size_t fixed_count = 0;
+    size_t none_count = 0;
+    size_t detect_count = 0;
+    // numeric header row, and a row looking like a header in the data section
+    writeFile("header_tmp.csv", "wb", "1;2\nid;value\n3;4\nid;value\n5;6\n");
+    scsv.setFileName("header_tmp.csv");
+    scsv.setSeparator(";");
+    try {
+        scsv.setHeaderMode(SlightCSV::HEADER_MODE_FIXED);
+        scsv.setHeaderRowCount(2);
+        scsv.loadData();
+        fixed_count = scsv.getHeaderCount();
+        scsv.getCell(cell, 0, 0);
+        scsv.unloadData();
+        scsv.setHeaderMode(SlightCSV::HEADER_MODE_NONE);
+        scsv.loadData();
+        none_count = scsv.getHeaderCount();
+        scsv.unloadData();
+        // detection ends at the first data row
+        scsv.setHeaderMode(SlightCSV::HEADER_MODE_DETECT);
+        scsv.setHeaderRowCount(3);
+        scsv.loadData();
+        detect_count = scsv.getHeaderCount();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(2, fixed_count);
+    CHECK_EQUAL("1", cell);
+    CHECK_EQUAL(0, none_count);
+    CHECK_EQUAL(0, detect_count);
+    CHECK_EQUAL(5, scsv.getRowCount());
+
+    // every row is checked by default
+    ex = "";
+    scsv.setHeaderRowCount(0);
+    try {
+        scsv.unloadData();
+        scsv.loadData();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("header_tmp.csv");
+    CHECK_EQUAL("CSV format error (intermediate header).", ex);
+};
+
+TEST(slightcsv, load_data_parallel_header_modes) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t detect_count = 0;
+    size_t fixed_count = 0;
+    size_t long_fixed_count = 0;
+    string contents = "id;value\n";
+    for (int i = 0; i < 100; ++i) {
+        contents += "1;2\n";
+    }
+    // header row in a later chunk is a data row
+    writeFile("parallel_tmp.csv", "wb", (contents + "id;value\n").c_str());
+    scsv.setFileName("parallel_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(64);
+    try {
+        scsv.setHeaderRowCount(5);
+        scsv.loadData();
+        detect_count = scsv.getHeaderCount();
+        scsv.unloadData();
+        scsv.setHeaderMode(SlightCSV::HEADER_MODE_FIXED);
+        scsv.setHeaderRowCount(1);
+        scsv.loadData();
+        fixed_count = scsv.getHeaderCount();
+        scsv.unloadData();
+        // header rows beyond the first chunk
+        scsv.setHeaderRowCount(60);
+        scsv.loadData();
+        long_fixed_count = scsv.getHeaderCount();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(1, detect_count);
+    CHECK_EQUAL(1, fixed_count);
+    CHECK_EQUAL(60, long_fixed_count);
+    CHECK_EQUAL(102, scsv.getRowCount());
+};
+
+TEST(slightcsv, utf8_policy_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(SlightCSV::UTF8_POLICY_THROW, scsv.getUtf8ErrorPolicy());
+    CHECK_EQUAL(0, scsv.getUtf8ErrorCount());
+    scsv.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_SKIP);
+    CHECK_EQUAL(SlightCSV::UTF8_POLICY_SKIP, scsv.getUtf8ErrorPolicy());
+    scsv.reset();
+    CHECK_EQUAL(SlightCSV::UTF8_POLICY_THROW, scsv.getUtf8ErrorPolicy());
+};
+
+TEST(slightcsv, load_data_utf8_policies) {
+    SlightCSV scsv;
+    string throw_ex = "";
+    string ex = "";
+    size_t throw_count = 0;
+    size_t abort_rows = 0;
+    size_t abort_count = 0;
+    string replaced_1, replaced_2, skipped_1, skipped_2;
+    vector<SlightCSV::Utf8Error> errors;
+    // invalid lead byte at offset 11, character broken by a plain byte at offset 16
+    writeFile("utf8_tmp.csv", "wb", "id;name\n1;a\xff" "b\n2;\xc3z\n3;c\n");
+    scsv.setFileName("utf8_tmp.csv");
+    scsv.setSeparator(";");
+    try {
+        scsv.loadData();
+    } catch(const exception &e) {
+        throw_ex = e.what();
+    }
+    throw_count = scsv.getUtf8ErrorCount();
+    try {
+        // the rows loaded before the exception are kept
+        scsv.unloadData();
+        scsv.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_ABORT);
+        abort_rows = scsv.loadData();
+        abort_count = scsv.getUtf8ErrorCount();
+        scsv.unloadData();
+        scsv.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_REPLACE);
+        scsv.loadData();
+        scsv.getCell(replaced_1, 1, 1);
+        scsv.getCell(replaced_2, 2, 1);
+        scsv.getUtf8Errors(errors);
+        scsv.unloadData();
+        scsv.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_SKIP);
+        scsv.loadData();
+        scsv.getCell(skipped_1, 1, 1);
+        scsv.getCell(skipped_2, 2, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("utf8_tmp.csv");
+    CHECK_EQUAL("UTF-8 format error.", throw_ex);
+    CHECK_EQUAL(1, throw_count);
+    CHECK_EQUAL("", ex);
+    // rows before the row of the invalid sequence
+    CHECK_EQUAL(1, abort_rows);
+    CHECK_EQUAL(1, abort_count);
+    CHECK_EQUAL("a\xef\xbf\xbd" "b", replaced_1);
+    CHECK_EQUAL("\xef\xbf\xbd" "z", replaced_2);
+    CHECK_EQUAL(2, errors.size());
+    CHECK_EQUAL(11, errors[0].m_offset);
+    CHECK_EQUAL(SlightCSV::UTF8_ERROR_INVALID_LEAD, errors[0].m_code);
+    CHECK_EQUAL(16, errors[1].m_offset);
+    CHECK_EQUAL(SlightCSV::UTF8_ERROR_INVALID_CONTINUATION, errors[1].m_code);
+    CHECK_EQUAL("ab", skipped_1);
+    CHECK_EQUAL("z", skipped_2);
+    CHECK_EQUAL(4, scsv.getRowCount());
+};
+
+TEST(slightcsv, load_data_parallel_utf8_policies) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t abort_rows = 0;
+    size_t replace_rows = 0;
+    vector<SlightCSV::Utf8Error> errors;
+    string contents = "id;value\n";
+    for (int i = 0; i < 100; ++i) {
+        contents += i == 70 ? "1;\x80\n" : "1;2\n";
+    }
+    writeFile("parallel_tmp.csv", "wb", contents.c_str());
+    scsv.setFileName("parallel_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(64);
+    try {
+        // the rows of the later chunks are dropped
+        scsv.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_ABORT);
+        abort_rows = scsv.loadData();
+        scsv.unloadData();
+        scsv.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_REPLACE);
+        replace_rows = scsv.loadData();
+        scsv.getUtf8Errors(errors);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(71, abort_rows);
+    CHECK_EQUAL(101, replace_rows);
+    CHECK_EQUAL(1, errors.size());
+    CHECK_EQUAL(9 + 70 * 4 + 2, errors[0].m_offset);
+};
+
+TEST(slightcsv, utf8_validation_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(true, scsv.getUtf8Validation());
+    scsv.setUtf8Validation(false);
+    CHECK_EQUAL(false, scsv.getUtf8Validation());
+    scsv.reset();
+    CHECK_EQUAL(true, scsv.getUtf8Validation());
+};
+
+TEST(slightcsv, load_data_utf8_validation) {
+    SlightCSV scsv;
+    SlightCSV trusted;
+    string ex = "";
+    vector<vector<string> > rows[3];
+    size_t error_count = 1;
+    string trusted_cell;
+    // long runs of multibyte characters, split between the chunks of the small buffer
+    string text = "";
+    for (int i = 0; i < 30; ++i) {
+        text += "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+    }
+    string contents = "id;name;note\n";
+    for (int i = 0; i < 20; ++i) {
+        contents += "1;" + text.substr(0, i * 9) + ";\"" + text + "\n;" + text + "\"\n";
+    }
+    writeFile("utf8_tmp.csv", "wb", contents.c_str());
+    scsv.setFileName("utf8_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setEscape("\"");
+    scsv.setHeaderMode(SlightCSV::HEADER_MODE_FIXED);
+    scsv.setHeaderRowCount(1);
+    scsv.setBufferSize(100);
+    try {
+        // validated, trusted and parsed character by character (the multibyte strip rule is never matched)
+        for (int k = 0; k < 3; ++k) {
+            scsv.setUtf8Validation(k != 1);
+            if (k == 2) {
+                set<string> strip_chars;
+                strip_chars.insert("\xc2\xa0");
+                scsv.setStripChars(strip_chars);
+            }
+            scsv.loadData();
+            rows[k].resize(scsv.getRowCount());
+            for (size_t i = 0; i < scsv.getRowCount(); ++i) {
+                scsv.getRow(rows[k][i], i);
+            }
+            scsv.unloadData();
+        }
+        // invalid sequences of trusted input are copied
+        writeFile("utf8_tmp.csv", "wb", "id;name\n1;a\xff" "b\n");
+        trusted.setFileName("utf8_tmp.csv");
+        trusted.setSeparator(";");
+        trusted.setUtf8Validation(false);
+        trusted.setUtf8ErrorPolicy(SlightCSV::UTF8_POLICY_SKIP);
+        trusted.loadData();
+        error_count = trusted.getUtf8ErrorCount();
+        trusted.getCell(trusted_cell, 1, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("utf8_tmp.csv");
+    CHECK_EQUAL("", ex);
+    // the header row is the first row of the matrix
+    CHECK_EQUAL(21, rows[0].size());
+    CHECK_EQUAL(text.substr(0, 45), rows[0][6][1]);
+    CHECK_EQUAL("\"" + text + "\n;" + text + "\"", rows[0][6][2]);
+    CHECK(rows[0] == rows[1]);
+    CHECK(rows[0] == rows[2]);
+    CHECK_EQUAL(0, error_count);
+    CHECK_EQUAL("a\xff" "b", trusted_cell);
+};
+
+TEST(slightcsv, empty_cell_mode_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(SlightCSV::EMPTY_CELL_NULL, scsv.getEmptyCellMode());
+    CHECK_EQUAL(SlightCSV::NULL_POLICY_VALUE, scsv.getNullPolicy());
+    CHECK_EQUAL("", scsv.getNullValue());
+    scsv.setEmptyCellMode(SlightCSV::EMPTY_CELL_ZERO);
+    scsv.setNullPolicy(SlightCSV::NULL_POLICY_THROW);
+    scsv.setNullValue("-1");
+    CHECK_EQUAL(SlightCSV::EMPTY_CELL_ZERO, scsv.getEmptyCellMode());
+    CHECK_EQUAL(SlightCSV::NULL_POLICY_THROW, scsv.getNullPolicy());
+    CHECK_EQUAL("-1", scsv.getNullValue());
+    scsv.reset();
+    CHECK_EQUAL(SlightCSV::EMPTY_CELL_NULL, scsv.getEmptyCellMode());
+    CHECK_EQUAL(SlightCSV::NULL_POLICY_VALUE, scsv.getNullPolicy());
+    CHECK_EQUAL("", scsv.getNullValue());
+};
+
+TEST(slightcsv, load_data_null_cells) {
+    SlightCSV scsv;
+    string ex = "";
+    string null_ex = "";
+    const char data[] = "id;a;b\n1;;0\n2;3;\n";
+    // specialized, generic and line by line parsing (rows are left to the row object if escape characters may be
+    // added by replacements)
+    const char *separators[] = {";", "|", "|"};
+    vector<string> rows[3];
+    vector<string> zero_row;
+    vector<int> column;
+    vector<int> null_column;
+    bool is_null[4] = {false, false, false, false};
+    int value = 1;
+    try {
+        for (int k = 0; k < 3; ++k) {
+            string k_data;
+            for (const char *c = data; *c; ++c) {
+                k_data += *c == ';' ? *separators[k] : *c;
+            }
+            scsv.reset();
+            scsv.setSeparator(separators[k]);
+            if (k == 2) {
+                map<string, string> rep_chars;
+                rep_chars["'"] = "\"";
+                scsv.setEscape("\"");
+                scsv.setReplaceChars(rep_chars);
+            }
+            scsv.loadData(k_data.data(), k_data.size());
+            scsv.getRow(rows[k], 1);
+            is_null[0] = is_null[0] || scsv.isNull(1, 1);
+            is_null[1] = is_null[1] || scsv.isNull(1, 2);
+            is_null[2] = is_null[2] || scsv.isNull(2, 2);
+        }
+        scsv.getCell(value, 2, 2);
+        scsv.setNullValue("-1");
+        scsv.getColumn(column, 1, 1);
+        // empty fields stored as zero are not null
+        scsv.unloadData();
+        scsv.setSeparator(";");
+        scsv.setEmptyCellMode(SlightCSV::EMPTY_CELL_ZERO);
+        scsv.loadData(data, sizeof(data) - 1);
+        scsv.getRow(zero_row, 2);
+        is_null[3] = scsv.isNull(2, 2);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    try {
+        scsv.unloadData();
+        scsv.setEmptyCellMode(SlightCSV::EMPTY_CELL_NULL);
+        scsv.setNullPolicy(SlightCSV::NULL_POLICY_THROW);
+        scsv.loadData(data, sizeof(data) - 1);
+        scsv.getColumn(null_column, 2);
+    } catch(const exception &e) {
+        null_ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(3, rows[0].size());
+    CHECK_EQUAL("", rows[0][1]);
+    CHECK_EQUAL("0", rows[0][2]);
+    CHECK(rows[0] == rows[1]);
+    CHECK(rows[0] == rows[2]);
+    CHECK_EQUAL(true, is_null[0]);
+    CHECK_EQUAL(false, is_null[1]);
+    CHECK_EQUAL(true, is_null[2]);
+    CHECK_EQUAL(0, value);
+    CHECK_EQUAL(2, column.size());
+    CHECK_EQUAL(-1, column[0]);
+    CHECK_EQUAL(3, column[1]);
+    CHECK_EQUAL("0", zero_row[2]);
+    CHECK_EQUAL(false, is_null[3]);
+    CHECK_EQUAL("Null cell (no value).", null_ex);
+};
+
+TEST(slightcsv, row_policy_default) {
+    SlightCSV scsv;
+    CHECK_EQUAL(SlightCSV::ROW_POLICY_THROW, scsv.getRowErrorPolicy());
+    CHECK_EQUAL(0, scsv.getRowErrorCount());
+    scsv.setRowErrorPolicy(SlightCSV::ROW_POLICY_QUARANTINE);
+    CHECK_EQUAL(SlightCSV::ROW_POLICY_QUARANTINE, scsv.getRowErrorPolicy());
+    scsv.reset();
+    CHECK_EQUAL(SlightCSV::ROW_POLICY_THROW, scsv.getRowErrorPolicy());
+};
+
+TEST(slightcsv, load_data_row_policies) {
+    SlightCSV scsv;
+    string throw_ex = "";
+    string ex = "";
+    size_t throw_count = 0;
+    size_t row_count = 0;
+    size_t error_count = 0;
+    bool buffer_sizes_ok = true;
+    bool row_object_ok = false;
+    string cell_1, cell_2;
+    vector<SlightCSV::RowError> errors;
+    vector<SlightCSV::RowError> small_errors;
+    // malformed rows at offsets 12 (CRLF), 24 (after an empty line), 34 (escaped new line) and 48 (unterminated)
+    writeFile("row_tmp.csv", "wb", "id;name\n1;a\n2;b;x\r\n3;c\n\n4\n5;\"e\nf\"\n6;\"g\nh\";z\n7;i\n8");
+    scsv.setFileName("row_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setEscape("\"");
+    scsv.setHeaderMode(SlightCSV::HEADER_MODE_FIXED);
+    scsv.setHeaderRowCount(1);
+    try {
+        scsv.loadData();
+    } catch(const exception &e) {
+        throw_ex = e.what();
+    }
+    throw_count = scsv.getRowErrorCount();
+    try {
+        scsv.unloadData();
+        scsv.setRowErrorPolicy(SlightCSV::ROW_POLICY_QUARANTINE);
+        row_count = scsv.loadData();
+        error_count = scsv.getRowErrorCount();
+        scsv.getRowErrors(errors);
+        scsv.getCell(cell_1, 2, 0);
+        scsv.getCell(cell_2, 4, 1);
+        // rows split between read buffers
+        for (size_t i = 1; i < 16; ++i) {
+            scsv.unloadData();
+            scsv.setBufferSize(i);
+            buffer_sizes_ok = buffer_sizes_ok && scsv.loadData() == row_count;
+            scsv.getRowErrors(small_errors);
+            buffer_sizes_ok = buffer_sizes_ok && small_errors.size() == errors.size();
+            for (size_t j = 0; buffer_sizes_ok && j < errors.size(); ++j) {
+                buffer_sizes_ok = small_errors[j].m_row == errors[j].m_row && 
+                    small_errors[j].m_offset == errors[j].m_offset && small_errors[j].m_text == errors[j].m_text;
+            }
+        }
+        // rows split into cells by the row object (replaced escape characters)
+        map<string, string> rep_chars;
+        rep_chars["'"] = "\"";
+        scsv.unloadData();
+        scsv.setReplaceChars(rep_chars);
+        row_object_ok = scsv.loadData() == row_count && scsv.getRowErrorCount() == error_count;
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("row_tmp.csv");
+    CHECK_EQUAL("CSV format error (cell count mismatch in row).", throw_ex);
+    CHECK_EQUAL(0, throw_count);
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(5, row_count);
+    CHECK_EQUAL("3", cell_1);
+    CHECK_EQUAL("i", cell_2);
+    CHECK_EQUAL(4, error_count);
+    CHECK_EQUAL(4, errors.size());
+    CHECK_EQUAL(2, errors[0].m_row);
+    CHECK_EQUAL(12, errors[0].m_offset);
+    CHECK_EQUAL(3, errors[0].m_cell_count);
+    CHECK_EQUAL("2;b;x", errors[0].m_text);
+    CHECK_EQUAL(4, errors[1].m_row);
+    CHECK_EQUAL(24, errors[1].m_offset);
+    CHECK_EQUAL(1, errors[1].m_cell_count);
+    CHECK_EQUAL("4", errors[1].m_text);
+    CHECK_EQUAL(6, errors[2].m_row);
+    CHECK_EQUAL(34, errors[2].m_offset);
+    CHECK_EQUAL("6;\"g\nh\";z", errors[2].m_text);
+    CHECK_EQUAL(8, errors[3].m_row);
+    CHECK_EQUAL(48, errors[3].m_offset);
+    CHECK_EQUAL("8", errors[3].m_text);
+    CHECK_EQUAL(true, buffer_sizes_ok);
+    CHECK_EQUAL(true, row_object_ok);
+};
+
+TEST(slightcsv, load_data_parallel_row_policies) {
+    SlightCSV scsv;
+    string ex = "";
+    size_t row_count = 0;
+    vector<SlightCSV::RowError> errors;
+    string contents = "id;value\n";
+    for (int i = 0; i < 100; ++i) {
+        contents += i % 30 == 20 ? "1;2;3\n" : "1;2\n";
+    }
+    writeFile("parallel_tmp.csv", "wb", contents.c_str());
+    scsv.setFileName("parallel_tmp.csv");
+    scsv.setSeparator(";");
+    scsv.setThreadCount(4);
+    scsv.setChunkSize(64);
+    scsv.setRowErrorPolicy(SlightCSV::ROW_POLICY_QUARANTINE);
+    try {
+        row_count = scsv.loadData();
+        scsv.getRowErrors(errors);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    remove("parallel_tmp.csv");
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(98, row_count);
+    CHECK_EQUAL(3, scsv.getRowErrorCount());
+    CHECK_EQUAL(3, errors.size());
+    CHECK_EQUAL(21, errors[0].m_row);
+    CHECK_EQUAL(9 + 20 * 4, errors[0].m_offset);
+    CHECK_EQUAL(81, errors[2].m_row);
+    CHECK_EQUAL(9 + 80 * 4 + 2 * 2, errors[2].m_offset);
+    CHECK_EQUAL("1;2;3", errors[2].m_text);
+};
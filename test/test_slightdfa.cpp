@@ -0,0 +1,131 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "test_include.hpp"
+
+TEST_GROUP(slightdfa) {
+};
+
+TEST(slightdfa, rows_new_line) {
+    SlightDfa dfa;
+    CHECK_EQUAL(true, dfa.setupRows(U8char("\""), set<U8char>(), map<U8char, U8char>()));
+    CHECK_EQUAL(SlightDfa::ACTION_ROW_END, dfa.getAction(SlightDfa::STATE_FIELD, '\n'));
+    CHECK_EQUAL(SlightDfa::ACTION_ROW_END, dfa.getAction(SlightDfa::STATE_FIELD, '\r'));
+    // escaped new lines are part of the row
+    CHECK_EQUAL(SlightDfa::ACTION_COPY, dfa.getAction(SlightDfa::STATE_QUOTED, '\n'));
+    CHECK_EQUAL(SlightDfa::STATE_QUOTED, dfa.getNext(SlightDfa::STATE_QUOTED, '\n'));
+    // the escape character toggles the state and it is kept
+    CHECK_EQUAL(SlightDfa::ACTION_COPY, dfa.getAction(SlightDfa::STATE_FIELD, '"'));
+    CHECK_EQUAL(SlightDfa::STATE_QUOTED, dfa.getNext(SlightDfa::STATE_FIELD, '"'));
+    CHECK_EQUAL(SlightDfa::STATE_FIELD, dfa.getNext(SlightDfa::STATE_QUOTED, '"'));
+    // NUL bytes are dropped
+    CHECK_EQUAL(SlightDfa::ACTION_SKIP, dfa.getAction(SlightDfa::STATE_FIELD, '\0'));
+};
+
+TEST(slightdfa, rows_strip_replace) {
+    SlightDfa dfa;
+    set<U8char> strip_chars;
+    map<U8char, U8char> rep_chars;
+    strip_chars.insert(U8char("\""));
+    rep_chars[U8char("a")] = U8char("\xc3\xa9");
+    CHECK_EQUAL(true, dfa.setupRows(U8char("\""), strip_chars, rep_chars));
+    // a stripped escape character does not toggle the state
+    CHECK_EQUAL(SlightDfa::ACTION_SKIP, dfa.getAction(SlightDfa::STATE_FIELD, '"'));
+    CHECK_EQUAL(SlightDfa::STATE_FIELD, dfa.getNext(SlightDfa::STATE_FIELD, '"'));
+    CHECK_EQUAL(SlightDfa::ACTION_REPLACE, dfa.getAction(SlightDfa::STATE_FIELD, 'a'));
+    CHECK_EQUAL("\xc3\xa9", dfa.getReplacement('a'));
+    // multibyte escape characters are not supported
+    CHECK_EQUAL(false, dfa.setupRows(U8char("\xc3\xa9"), strip_chars, rep_chars));
+};
+
+TEST(slightdfa, rules) {
+    SlightDfa dfa;
+    set<U8char> strip_chars;
+    map<U8char, U8char> rep_chars;
+    const string *replacement = 0;
+    strip_chars.insert(U8char("x"));
+    strip_chars.insert(U8char("\xe2\x82\xac"));
+    rep_chars[U8char("\xe2\x82\xac")] = U8char("E");
+    rep_chars[U8char("\xf0\x9f\x98\x80")] = U8char(":");
+    // many multibyte keys (Cyrillic letters) in the hash table
+    for (unsigned c = 0x410; c < 0x450; ++c) {
+        char bytes[3] = {(char)(0xc0 | (c >> 6)), (char)(0x80 | (c & 0x3f)), 0};
+        rep_chars[U8char(bytes)] = U8char("c");
+    }
+    CHECK_EQUAL(true, dfa.setupRows(U8char("\""), strip_chars, rep_chars));
+    CHECK_EQUAL(true, dfa.hasMultibyteRules());
+    CHECK_EQUAL(SlightDfa::RULE_STRIP, dfa.getRule("x", 1, replacement));
+    CHECK_EQUAL(SlightDfa::RULE_NONE, dfa.getRule("y", 1, replacement));
+    // stripping takes precedence over replacing
+    CHECK_EQUAL(SlightDfa::RULE_STRIP, dfa.getRule("\xe2\x82\xac", 3, replacement));
+    CHECK_EQUAL(SlightDfa::RULE_REPLACE, dfa.getRule("\xf0\x9f\x98\x80", 4, replacement));
+    CHECK_EQUAL(":", *replacement);
+    for (unsigned c = 0x410; c < 0x450; ++c) {
+        char bytes[2] = {(char)(0xc0 | (c >> 6)), (char)(0x80 | (c & 0x3f))};
+        replacement = 0;
+        CHECK_EQUAL(SlightDfa::RULE_REPLACE, dfa.getRule(bytes, 2, replacement));
+        CHECK_EQUAL("c", *replacement);
+    }
+    CHECK_EQUAL(SlightDfa::RULE_NONE, dfa.getRule("\xc3\xa9", 2, replacement));
+    CHECK_EQUAL(SlightDfa::RULE_NONE, dfa.getRule("\xe2\x82\xad", 3, replacement));
+};
+
+TEST(slightdfa, cells) {
+    SlightDfa dfa;
+    CHECK_EQUAL(true, dfa.setupCells(U8char(";"), U8char("\"")));
+    CHECK_EQUAL(SlightDfa::ACTION_EMPTY_CELL, dfa.getAction(SlightDfa::STATE_EMPTY, ';'));
+    CHECK_EQUAL(SlightDfa::ACTION_EMPTY_CELL, dfa.getAction(SlightDfa::STATE_AFTER_SEPARATOR, ';'));
+    CHECK_EQUAL(SlightDfa::ACTION_CELL_END, dfa.getAction(SlightDfa::STATE_FIELD, ';'));
+    CHECK_EQUAL(SlightDfa::STATE_AFTER_SEPARATOR, dfa.getNext(SlightDfa::STATE_FIELD, ';'));
+    CHECK_EQUAL(SlightDfa::ACTION_COPY, dfa.getAction(SlightDfa::STATE_QUOTED, ';'));
+    CHECK_EQUAL(SlightDfa::STATE_FIELD, dfa.getNext(SlightDfa::STATE_AFTER_SEPARATOR, '1'));
+    CHECK_EQUAL(SlightDfa::STATE_QUOTED, dfa.getNext(SlightDfa::STATE_AFTER_SEPARATOR, '"'));
+    // a NUL byte after a separator does not add to the cell, but the separator is not the last character any more
+    CHECK_EQUAL(SlightDfa::STATE_EMPTY, dfa.getNext(SlightDfa::STATE_AFTER_SEPARATOR, '\0'));
+    CHECK_EQUAL(SlightDfa::ACTION_MULTIBYTE, dfa.getAction(SlightDfa::STATE_EMPTY, '\xc3'));
+    CHECK_EQUAL(SlightDfa::STATE_FIELD, dfa.getNext(SlightDfa::STATE_EMPTY, '\xc3'));
+    CHECK_EQUAL(SlightDfa::ACTION_ERROR, dfa.getAction(SlightDfa::STATE_FIELD, '\x80'));
+    CHECK_EQUAL(false, dfa.setupCells(U8char("\xc3\xa9"), U8char("\"")));
+};
+
+TEST(slightdfa, char_length) {
+    string ex = "";
+    CHECK_EQUAL(2, SlightDfa::getCharLength("\xc3\xa9", 2));
+    CHECK_EQUAL(3, SlightDfa::getCharLength("\xe2\x82\xac", 3));
+    CHECK_EQUAL(4, SlightDfa::getCharLength("\xf0\x9f\x98\x80", 4));
+    // continued in the next chunk
+    CHECK_EQUAL(0, SlightDfa::getCharLength("\xe2\x82", 2));
+    try {
+        SlightDfa::getCharLength("\xe2\x82" "a", 3);
+    } catch (const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("UTF-8 format error.", ex);
+};
+
+TEST(slightdfa, check_char) {
+    size_t length = 0;
+    CHECK_EQUAL(U8char::STATUS_VALID, SlightDfa::checkChar("\xe2\x82\xac", 3, length));
+    CHECK_EQUAL(3, length);
+    CHECK_EQUAL(U8char::STATUS_INCOMPLETE, SlightDfa::checkChar("\xe2\x82", 2, length));
+    // the bytes up to the one breaking the sequence
+    CHECK_EQUAL(U8char::STATUS_INVALID_CONTINUATION, SlightDfa::checkChar("\xe2\x82" "a", 3, length));
+    CHECK_EQUAL(2, length);
+    CHECK_EQUAL(U8char::STATUS_INVALID_CONTINUATION, SlightDfa::checkChar("\xf0" ";", 2, length));
+    CHECK_EQUAL(1, length);
+    CHECK_EQUAL(U8char::STATUS_INVALID_LEAD, SlightDfa::checkChar("\x80", 1, length));
+    CHECK_EQUAL(1, length);
+};
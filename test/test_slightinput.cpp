@@ -0,0 +1,389 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "test_include.hpp"
+
+#include <cstdio>
+#include <unistd.h>
+
+TEST_GROUP(slightinput) {
+};
+
+TEST(slightinput, mmap_open_wrong_filename) {
+    SlightMmapInput in;
+    string ex = "";
+    try {
+        in.open("abc.def");
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Input cannot be opened.", ex);
+};
+
+TEST(slightinput, mmap_zero_window_size) {
+    SlightMmapInput in;
+    string ex = "";
+    try {
+        in.setWindowSize(0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Invalid parameter.", ex);
+};
+
+TEST(slightinput, mmap_read_before_open) {
+    SlightMmapInput in;
+    const char *data = 0;
+    size_t size = 0;
+    CHECK_EQUAL(false, in.read(data, size));
+    CHECK_EQUAL(0, in.getSize());
+};
+
+TEST(slightinput, mmap_read_windows) {
+    SlightMmapInput in;
+    string ex = "";
+    string mapped = "";
+    string expected = "";
+    size_t chunk_count = 0;
+    const char *data;
+    size_t size;
+    // read reference contents through stdio
+    FILE *f = fopen("../../test/env_data_short.csv", "rb");
+    int c;
+    while (c = fgetc(f), c != EOF) {
+        expected += (char)c;
+    }
+    fclose(f);
+    try {
+        in.setWindowSize(4096);
+        in.open("../../test/env_data_short.csv");
+        while (in.read(data, size)) {
+            mapped.append(data, size);
+            ++chunk_count;
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(expected.size(), in.getSize());
+    CHECK_EQUAL((expected.size() + 4095) / 4096, chunk_count);
+    CHECK_EQUAL(expected, mapped);
+};
+
+TEST(slightinput, file_open_wrong_filename) {
+    SlightFileInput in;
+    string ex = "";
+    try {
+        in.open("abc.def");
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Input cannot be opened.", ex);
+};
+
+TEST(slightinput, file_zero_buffer_size) {
+    SlightFileInput in;
+    string ex = "";
+    try {
+        in.setBufferSize(0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Invalid parameter.", ex);
+};
+
+TEST(slightinput, file_read_blocks) {
+    SlightFileInput in;
+    SlightMmapInput in_mmap;
+    string ex = "";
+    string read = "";
+    string expected = "";
+    size_t chunk_count = 0;
+    const char *data;
+    size_t size;
+    try {
+        // mapped contents serve as reference
+        in_mmap.open("../../test/env_data_short.csv");
+        while (in_mmap.read(data, size)) {
+            expected.append(data, size);
+        }
+        in.setBufferSize(1000);
+        in.open("../../test/env_data_short.csv");
+        while (in.read(data, size)) {
+            read.append(data, size);
+            ++chunk_count;
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(expected.size(), in.getSize());
+    CHECK_EQUAL((expected.size() + 999) / 1000, chunk_count);
+    CHECK_EQUAL(expected, read);
+};
+
+TEST(slightinput, memory_open_null) {
+    SlightMemoryInput in;
+    string ex = "";
+    try {
+        in.open(0, 1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Input cannot be opened.", ex);
+};
+
+TEST(slightinput, memory_read_no_copy) {
+    SlightMemoryInput in;
+    const char buffer[] = "a;b\n1;2\n";
+    const char *data = 0;
+    size_t size = 0;
+    in.open(buffer, sizeof(buffer) - 1);
+    CHECK_EQUAL(8, in.getSize());
+    CHECK_EQUAL(true, in.read(data, size));
+    CHECK_EQUAL(buffer, data);
+    CHECK_EQUAL(8, size);
+    CHECK_EQUAL(false, in.read(data, size));
+};
+
+TEST(slightinput, read_ahead_buffer_count_too_low) {
+    SlightReadAheadInput in;
+    string ex = "";
+    try {
+        in.setBufferCount(1);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Invalid parameter.", ex);
+};
+
+TEST(slightinput, read_ahead_read_blocks) {
+    SlightFileInput in_file;
+    SlightMmapInput in_mmap;
+    SlightReadAheadInput in;
+    string ex = "";
+    string read = "";
+    string expected = "";
+    const char *data;
+    size_t size;
+    try {
+        in_mmap.open("../../test/env_data_short.csv");
+        while (in_mmap.read(data, size)) {
+            expected.append(data, size);
+        }
+        in_file.setBufferSize(333);
+        in_file.open("../../test/env_data_short.csv");
+        in.setBufferCount(3);
+        in.open(in_file);
+        while (in.read(data, size)) {
+            read.append(data, size);
+        }
+        in.close();
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(expected, read);
+    CHECK_EQUAL(true, in.getStallTime() >= 0);
+};
+
+TEST(slightinput, uring_zero_queue_depth) {
+    SlightUringInput in;
+    string ex = "";
+    try {
+        in.setQueueDepth(0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Invalid parameter.", ex);
+};
+
+TEST(slightinput, uring_read_blocks) {
+    SlightUringInput in;
+    SlightMmapInput in_mmap;
+    string ex = "";
+    string read = "";
+    string expected = "";
+    const char *data;
+    size_t size;
+    if (!SlightUringInput::isAvailable()) {
+        return;
+    }
+    try {
+        in_mmap.open("../../test/env_data.csv");
+        while (in_mmap.read(data, size)) {
+            expected.append(data, size);
+        }
+        in.setBufferSize(1000);
+        in.setQueueDepth(5);
+        in.open("../../test/env_data.csv");
+        while (in.read(data, size)) {
+            read.append(data, size);
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(expected.size(), in.getSize());
+    CHECK_EQUAL(expected, read);
+};
+
+TEST(slightinput, decompress_passthrough) {
+    SlightMemoryInput in_memory;
+    SlightDecompressInput in;
+    const char buffer[] = "a;b\n1;2\n";
+    const char *data = 0;
+    size_t size = 0;
+    in_memory.open(buffer, sizeof(buffer) - 1);
+    in.open(in_memory);
+    CHECK_EQUAL(SlightDecompressInput::FORMAT_NONE, in.getFormat());
+    CHECK_EQUAL(sizeof(buffer) - 1, in.getSize());
+    CHECK_EQUAL(true, in.read(data, size));
+    // uncompressed chunks are not copied
+    CHECK_EQUAL(true, data == buffer);
+    CHECK_EQUAL(sizeof(buffer) - 1, size);
+    CHECK_EQUAL(false, in.read(data, size));
+};
+
+TEST(slightinput, decompress_gzip_small_chunks) {
+    SlightFileInput in_file;
+    SlightDecompressInput in;
+    string ex = "";
+    string read = "";
+    const char *data;
+    size_t size;
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_GZIP)) {
+        return;
+    }
+    try {
+        // magic bytes are split between source chunks
+        in_file.setBufferSize(1);
+        in_file.open("../../test/escaped_nl.csv.gz");
+        in.setBufferSize(3);
+        in.open(in_file);
+        while (in.read(data, size)) {
+            read.append(data, size);
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(SlightDecompressInput::FORMAT_GZIP, in.getFormat());
+    CHECK_EQUAL("id;name;note\n1;\"Jürgen\nMüller\";€5\n2;\"a;b\";¥7\n", read);
+};
+
+TEST(slightinput, decompress_gzip_truncated) {
+    SlightFileInput in_file;
+    SlightDecompressInput in;
+    string ex = "";
+    const char *data;
+    size_t size;
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_GZIP)) {
+        return;
+    }
+    try {
+        in_file.open("../../test/escaped_nl_trunc.csv.gz");
+        in.open(in_file);
+        while (in.read(data, size)) {
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Unexpected error occurred while reading input.", ex);
+};
+
+TEST(slightinput, decompress_zstd) {
+    SlightFileInput in_file;
+    SlightDecompressInput in;
+    string ex = "";
+    string read = "";
+    const char *data;
+    size_t size;
+    try {
+        in_file.open("../../test/escaped_nl.csv.zst");
+        in.open(in_file);
+        while (in.read(data, size)) {
+            read.append(data, size);
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    if (!SlightDecompressInput::isSupported(SlightDecompressInput::FORMAT_ZSTD)) {
+        CHECK_EQUAL("Input type not supported.", ex);
+        return;
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(SlightDecompressInput::FORMAT_ZSTD, in.getFormat());
+    // the frame header stores the decompressed size
+    CHECK_EQUAL(read.size(), in.getSize());
+    CHECK_EQUAL("id;name;note\n1;\"Jürgen\nMüller\";€5\n2;\"a;b\";¥7\n", read);
+};
+
+TEST(slightinput, stream_open_null) {
+    SlightStreamInput in;
+    string ex = "";
+    try {
+        in.open((FILE*)0);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("Input cannot be opened.", ex);
+};
+
+TEST(slightinput, stream_pipe) {
+    SlightStreamInput in;
+    string ex = "";
+    string read = "";
+    const char *data;
+    size_t size;
+    int fds[2];
+    CHECK_EQUAL(0, pipe(fds));
+    CHECK_EQUAL(9, write(fds[1], "a;b\n1;2\n3", 9));
+    close(fds[1]);
+    try {
+        in.setBufferSize(4);
+        in.open(fds[0]);
+        while (in.read(data, size)) {
+            read.append(data, size);
+        }
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    close(fds[0]);
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(0, in.getSize());
+    CHECK_EQUAL("a;b\n1;2\n3", read);
+};
+
+TEST(slightinput, file_not_seekable) {
+    SlightFileInput in;
+    string ex = "";
+    char filename[32];
+    FILE *f = popen("printf 'a;b'", "r");
+    CHECK(f != 0);
+    // the read end of the pipe, opened by name
+    snprintf(filename, sizeof(filename), "/dev/fd/%d", fileno(f));
+    try {
+        in.open(filename);
+    } catch(const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("", ex);
+    CHECK_EQUAL(false, in.getIsSeekable());
+    CHECK_EQUAL(0, in.getSize());
+    in.close();
+    pclose(f);
+};
@@ -1590,4 +1590,264 @@ TEST(slightmatrix, set_get_column_bad_row_index_ex_3) {
         msg = e.what();
     }
     CHECK_EQUAL("Invalid row count or index.", msg);
-}
\ No newline at end of file
+}
+TEST(slightmatrix, remove_rows) {
+    string msg = "";
+    string cell = "";
+    vector<string> cells;
+    SlightMatrix sm;
+    try {
+        sm.setColumnCount(2);
+        cells.push_back("h1");
+        cells.push_back("h2");
+        sm.addCells(cells);
+        sm.setHeaderCount(1);
+        cells[0] = "abc";
+        cells[1] = "def";
+        sm.addCells(cells);
+        sm.addCells(cells);
+        sm.removeRows(1);
+        sm.getCell(cell, 1, 1);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("", msg);
+    CHECK_EQUAL(2, sm.getRowCount());
+    CHECK_EQUAL("def", cell);
+    sm.removeRows(2);
+    CHECK_EQUAL(0, sm.getRowCount());
+    CHECK_EQUAL(0, sm.getHeaderCount());
+}
+
+TEST(slightmatrix, remove_rows_ex) {
+    string msg = "";
+    vector<string> cells;
+    try {
+        SlightMatrix sm;
+        sm.setColumnCount(1);
+        cells.push_back("abc");
+        sm.addCells(cells);
+        sm.removeRows(2);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("Invalid row count or index.", msg);
+}
+
+TEST(slightmatrix, remove_rows_index) {
+    string msg = "";
+    string cell = "";
+    vector<string> cells(1);
+    SlightMatrix sm;
+    try {
+        sm.setColumnCount(1);
+        for (size_t i = 0; i < 5; ++i) {
+            cells[0] = string(1, (char)('a' + i));
+            sm.addCells(cells);
+        }
+        sm.setHeaderCount(2);
+        sm.removeRows(1, 2);
+        sm.getCell(cell, 1, 0);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("", msg);
+    CHECK_EQUAL(3, sm.getRowCount());
+    CHECK_EQUAL(1, sm.getHeaderCount());
+    CHECK_EQUAL("d", cell);
+    try {
+        sm.removeRows(2, 2);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("Invalid row count or index.", msg);
+}
+
+TEST(slightmatrix, set_row) {
+    string msg = "";
+    string cell = "";
+    vector<string> cells;
+    SlightMatrix sm;
+    try {
+        sm.setColumnCount(2);
+        sm.setRowCount(3);
+        cells.push_back("abc");
+        cells.push_back("def");
+        sm.setRow(2, cells);
+        sm.getCell(cell, 2, 1);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("", msg);
+    CHECK_EQUAL(3, sm.getRowCount());
+    CHECK_EQUAL(6, sm.getCapacity());
+    CHECK_EQUAL("def", cell);
+    // cells are swapped
+    CHECK_EQUAL("", cells[1]);
+    sm.getCell(cell, 0, 0);
+    CHECK_EQUAL("", cell);
+    sm.setRowCount(1);
+    CHECK_EQUAL(1, sm.getRowCount());
+}
+
+TEST(slightmatrix, set_row_ex) {
+    string column_msg = "";
+    string row_msg = "";
+    string count_msg = "";
+    vector<string> cells(2);
+    SlightMatrix sm;
+    try {
+        sm.setRowCount(1);
+    } catch (const exception &e) {
+        count_msg = e.what();
+    }
+    sm.setColumnCount(2);
+    sm.setRowCount(1);
+    try {
+        sm.setRow(1, cells);
+    } catch (const exception &e) {
+        row_msg = e.what();
+    }
+    cells.push_back("");
+    try {
+        sm.setRow(0, cells);
+    } catch (const exception &e) {
+        column_msg = e.what();
+    }
+    CHECK_EQUAL("Invalid column count or index.", count_msg);
+    CHECK_EQUAL("Invalid row count or index.", row_msg);
+    CHECK_EQUAL("Invalid column count or index.", column_msg);
+}
+
+TEST(slightmatrix, append_rows) {
+    string msg = "";
+    string cell = "";
+    vector<string> cells;
+    SlightMatrix sm;
+    SlightMatrix source;
+    try {
+        sm.setColumnCount(2);
+        cells.push_back("abc");
+        cells.push_back("def");
+        sm.addCells(cells);
+        source.setColumnCount(2);
+        cells[0] = "h1";
+        cells[1] = "h2";
+        source.addCells(cells);
+        source.setHeaderCount(1);
+        cells[0] = "ghi";
+        cells[1] = "jkl";
+        source.addCells(cells);
+        sm.appendRows(source, 1);
+        sm.getCell(cell, 1, 1);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("", msg);
+    CHECK_EQUAL(2, sm.getRowCount());
+    CHECK_EQUAL("jkl", cell);
+    CHECK_EQUAL(0, source.getRowCount());
+}
+
+TEST(slightmatrix, append_rows_column_ex) {
+    string msg = "";
+    vector<string> cells;
+    try {
+        SlightMatrix sm;
+        SlightMatrix source;
+        sm.setColumnCount(2);
+        source.setColumnCount(1);
+        cells.push_back("abc");
+        source.addCells(cells);
+        sm.appendRows(source, 0);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("Invalid column count or index.", msg);
+}
+
+TEST(slightmatrix, growth_factor) {
+    string msg = "";
+    SlightMatrix sm;
+    CHECK_EQUAL(2, sm.getGrowthFactor());
+    try {
+        sm.setGrowthFactor(1);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("Invalid parameter.", msg);
+    sm.setGrowthFactor(1.5);
+    CHECK_EQUAL(1.5, sm.getGrowthFactor());
+}
+
+TEST(slightmatrix, growth_keeps_cells) {
+    string msg = "";
+    string cell;
+    vector<string> row(2);
+    SlightMatrix sm;
+    try {
+        sm.setColumnCount(2);
+        sm.setCapacity(4);
+        for (size_t i = 0; i < 3000; ++i) {
+            row[0] = "a long cell content that does not fit into a small string";
+            row[1] = string(i % 50, 'x');
+            sm.addCells(row);
+        }
+        sm.getCell(cell, 2999, 1);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    CHECK_EQUAL("", msg);
+    CHECK_EQUAL(3000, sm.getRowCount());
+    CHECK_EQUAL(string(2999 % 50, 'x'), cell);
+    // capacity grows geometrically from the size set
+    CHECK(sm.getCapacity() >= 6000);
+    CHECK(sm.getCapacity() <= 8192);
+}
+
+TEST(slightmatrix, null_cells) {
+    string msg = "";
+    string null_msg = "";
+    vector<string> row;
+    int i_value = 1;
+    double d_value = 0;
+    string s_value = "x";
+    vector<int> column;
+    SlightMatrix sm;
+    CHECK_EQUAL(SlightMatrix::NULL_POLICY_VALUE, sm.getNullPolicy());
+    CHECK_EQUAL("", sm.getNullValue());
+    row.push_back("1");
+    row.push_back("");
+    try {
+        sm.setColumnCount(2);
+        sm.addCells(row);
+        sm.addCells(row);
+        // empty cells are null, converted from the null value
+        sm.getCell(i_value, 0, 1);
+        sm.getCell(s_value, 0, 1);
+        sm.setNullValue("nan");
+        sm.getCell(d_value, 1, 1);
+        sm.getColumn(column, 1);
+    } catch (const exception &e) {
+        msg = e.what();
+    }
+    try {
+        sm.setNullPolicy(SlightMatrix::NULL_POLICY_THROW);
+        sm.getCell(i_value, 1, 1);
+    } catch (const exception &e) {
+        null_msg = e.what();
+    }
+    CHECK_EQUAL("", msg);
+    CHECK_EQUAL(true, sm.isNull(0, 1));
+    CHECK_EQUAL(false, sm.isNull(0, 0));
+    CHECK_EQUAL(0, i_value);
+    CHECK_EQUAL("", s_value);
+    CHECK(d_value != d_value);
+    CHECK_EQUAL(2, column.size());
+    CHECK_EQUAL(0, column[1]);
+    CHECK_EQUAL("Null cell (no value).", null_msg);
+    // the settings are kept by reset()
+    sm.reset();
+    CHECK_EQUAL(SlightMatrix::NULL_POLICY_THROW, sm.getNullPolicy());
+    CHECK_EQUAL("nan", sm.getNullValue());
+}
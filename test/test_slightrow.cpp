@@ -457,12 +457,12 @@ TEST(slightrow, getcells_ok_2) {
         exs = e.what();
     }
     CHECK_EQUAL(31, vect.size());
-    CHECK_EQUAL("0", vect.at(0));
+    CHECK_EQUAL("", vect.at(0));
     CHECK_EQUAL("es", vect.at(1));
-    CHECK_EQUAL("0", vect.at(2));
+    CHECK_EQUAL("", vect.at(2));
     CHECK_EQUAL("es", vect.at(3));
     CHECK_EQUAL("es", vect.at(29));
-    CHECK_EQUAL("0", vect.at(30));
+    CHECK_EQUAL("", vect.at(30));
 }
 
 TEST(slightrow, reset_1) {
@@ -584,7 +584,7 @@ TEST(slightrow, escape_quotes_2) {
     CHECK_EQUAL("test", vect.at(0));
     CHECK_EQUAL("test", vect.at(1));
     CHECK_EQUAL("\"test,test\"", vect.at(2));
-    CHECK_EQUAL("0", vect.at(3));
+    CHECK_EQUAL("", vect.at(3));
 }
 
 TEST(slightrow, escape_quotes_3) {
@@ -600,11 +600,11 @@ TEST(slightrow, escape_quotes_3) {
     row.getCells(vect);
     CHECK_EQUAL(6, vect.size());
     CHECK_EQUAL("test", vect.at(0));
-    CHECK_EQUAL("0", vect.at(1));
+    CHECK_EQUAL("", vect.at(1));
     CHECK_EQUAL("test", vect.at(2));
     CHECK_EQUAL("\"test,,test\"", vect.at(3));
-    CHECK_EQUAL("0", vect.at(4));
-    CHECK_EQUAL("0", vect.at(5));
+    CHECK_EQUAL("", vect.at(4));
+    CHECK_EQUAL("", vect.at(5));
 }
 
 TEST(slightrow, escape_quotes_4) {
@@ -620,7 +620,7 @@ TEST(slightrow, escape_quotes_4) {
     row.getCells(vect);
     CHECK_EQUAL(4, vect.size());
     CHECK_EQUAL("test", vect.at(0));
-    CHECK_EQUAL("0", vect.at(1));
+    CHECK_EQUAL("", vect.at(1));
     CHECK_EQUAL("test", vect.at(2));
     CHECK_EQUAL("\"test,,test,,", vect.at(3));
 }
@@ -639,7 +639,7 @@ TEST(slightrow, escape_quotes_5) {
     CHECK_EQUAL(3, vect.size());
     CHECK_EQUAL("\"test,,test,\"test", vect.at(0));
     CHECK_EQUAL("\",test,\"", vect.at(1));
-    CHECK_EQUAL("0", vect.at(2));
+    CHECK_EQUAL("", vect.at(2));
 }
 
 TEST(slightrow, escape_quotes_6) {
@@ -854,3 +854,51 @@ TEST(slightrow, set_escape_process_ok_3) {
     CHECK_EQUAL("\"row,with\"", cell);
 }
 
+
+TEST(slightrow, process_empty_and_escaped_cells) {
+    SlightRow row;
+    vector<string> cells;
+    row.setSeparator(U8char(";"));
+    row.setEscape(U8char("\""));
+    row.setInput(";\"a;\xc3\xa9\";;b;");
+    row.process();
+    row.getCells(cells);
+    CHECK_EQUAL(5, cells.size());
+    CHECK_EQUAL("", cells[0]);
+    CHECK_EQUAL("\"a;\xc3\xa9\"", cells[1]);
+    CHECK_EQUAL("", cells[2]);
+    CHECK_EQUAL("b", cells[3]);
+    CHECK_EQUAL("", cells[4]);
+    // empty fields stored as zero
+    CHECK_EQUAL(false, row.getEmptyCellZero());
+    row.setEmptyCellZero(true);
+    row.setInput(";\"a;\xc3\xa9\";;b;");
+    row.process();
+    row.getCells(cells);
+    CHECK_EQUAL(5, cells.size());
+    CHECK_EQUAL("0", cells[0]);
+    CHECK_EQUAL("0", cells[2]);
+    CHECK_EQUAL("0", cells[4]);
+    row.reset();
+    CHECK_EQUAL(false, row.getEmptyCellZero());
+}
+
+TEST(slightrow, process_utf8_error) {
+    SlightRow row;
+    string ex = "";
+    row.setSeparator(U8char(";"));
+    row.setInput("a;\xc3" "b;c");
+    try {
+        row.process();
+    } catch (const exception &e) {
+        ex = e.what();
+    }
+    CHECK_EQUAL("UTF-8 format error.", ex);
+}
+
+TEST(slightrow, get_is_header_statistics) {
+    // at most 10 percent numeric characters
+    CHECK_EQUAL(true, SlightRow::getIsHeader(0, 10));
+    CHECK_EQUAL(true, SlightRow::getIsHeader(1, 10));
+    CHECK_EQUAL(false, SlightRow::getIsHeader(2, 10));
+}
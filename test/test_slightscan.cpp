@@ -0,0 +1,231 @@
+// SlightCSV - simple, lightweight CSV parser library written in C++
+// Copyright (C) 2018 Simon Horvath <horvathsg@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "test_include.hpp"
+
+#include <cstdlib>
+
+TEST_GROUP(slightscan) {
+};
+
+// scanner set up the way the parser splits rows
+static void setupRowScanner(SlightScanner &t_scanner) {
+    t_scanner.addTarget('\n');
+    t_scanner.addTarget('\r');
+    t_scanner.addStop(0);
+    t_scanner.setEscape('"');
+}
+
+TEST(slightscan, add_bytes) {
+    SlightScanner scanner;
+    CHECK_EQUAL(true, scanner.addTarget(';'));
+    CHECK_EQUAL(true, scanner.addTarget(';'));
+    // multibyte characters cannot be searched for
+    CHECK_EQUAL(false, scanner.addStop((char)0xc3));
+    for (char c = 'a'; c < 'a' + (char)SlightScanner::MAX_BYTE_COUNT - 1; ++c) {
+        CHECK_EQUAL(true, scanner.addStop(c));
+    }
+    CHECK_EQUAL(false, scanner.setEscape('"'));
+    scanner.clear();
+    CHECK_EQUAL(true, scanner.setEscape('"'));
+};
+
+TEST(slightscan, instruction_set) {
+    SlightScanner scanner;
+    CHECK_EQUAL(SlightScanner::getBestInstructionSet(), scanner.getInstructionSet());
+    scanner.setInstructionSet(SlightScanner::ISET_SCALAR);
+    CHECK_EQUAL(SlightScanner::ISET_SCALAR, scanner.getInstructionSet());
+    // falls back to the best supported one
+    scanner.setInstructionSet(SlightScanner::ISET_AVX512);
+    CHECK_EQUAL(SlightScanner::getBestInstructionSet(), scanner.getInstructionSet());
+};
+
+TEST(slightscan, find_target) {
+    SlightScanner scanner;
+    bool is_escaped = false;
+    setupRowScanner(scanner);
+    string data = "10;0;0;10;0;0;10;0;0;10;0;0;10;0;0;10;0;0;10;0;0;10;0;0;10;0;0;10;0;0\n9;0;0";
+    CHECK_EQUAL(data.find('\n'), scanner.find(data.data(), data.size(), is_escaped));
+    CHECK_EQUAL(false, is_escaped);
+    // not found
+    CHECK_EQUAL(5, scanner.find("9;0;0", 5, is_escaped));
+    CHECK_EQUAL(0, scanner.find("", 0, is_escaped));
+};
+
+TEST(slightscan, find_escaped_across_blocks) {
+    SlightScanner scanner;
+    bool is_escaped = false;
+    setupRowScanner(scanner);
+    // the new lines in the escaped region spanning the block boundary are not targets
+    string data = string(60, 'a') + "\"b\nc" + string(70, '\n') + "d\"e\nf";
+    size_t index = scanner.find(data.data(), data.size(), is_escaped);
+    CHECK_EQUAL(data.rfind('\n'), index);
+    CHECK_EQUAL(false, is_escaped);
+    // the escaped state is carried over from the previous call
+    is_escaped = true;
+    CHECK_EQUAL(4, scanner.find("a\nb\"\n", 5, is_escaped));
+    CHECK_EQUAL(false, is_escaped);
+    // and returned at the end of the data
+    CHECK_EQUAL(3, scanner.find("a\"b", 3, is_escaped));
+    CHECK_EQUAL(true, is_escaped);
+};
+
+TEST(slightscan, find_stop) {
+    SlightScanner scanner;
+    bool is_escaped = false;
+    setupRowScanner(scanner);
+    scanner.addStop('"');
+    // stop bytes are reported in escaped regions as well, the escape byte is a stop byte now
+    CHECK_EQUAL(1, scanner.find("a\"b\nc", 5, is_escaped));
+    CHECK_EQUAL(false, is_escaped);
+    // bytes of multibyte characters are stop bytes
+    string data = string(100, 'a') + "\xc3\xa9";
+    CHECK_EQUAL(100, scanner.find(data.data(), data.size(), is_escaped));
+    CHECK_EQUAL(3, scanner.find(string("abc\0d", 5).data(), 5, is_escaped));
+};
+
+TEST(slightscan, instruction_sets_match) {
+    const char alphabet[] = "ab;\"\n\r\xc3";
+    string data;
+    srand(1);
+    for (size_t i = 0; i < 5000; ++i) {
+        data += alphabet[rand() % (sizeof(alphabet) - 1)];
+    }
+    for (int iset = SlightScanner::ISET_SSE2; iset <= SlightScanner::ISET_AVX512; ++iset) {
+        SlightScanner reference;
+        SlightScanner scanner;
+        setupRowScanner(reference);
+        setupRowScanner(scanner);
+        reference.setInstructionSet(SlightScanner::ISET_SCALAR);
+        scanner.setInstructionSet((SlightScanner::InstructionSet)iset);
+        // walk the data the way the parser does (continue after each byte found)
+        bool reference_escaped = false;
+        bool is_escaped = false;
+        size_t reference_position = 0;
+        size_t position = 0;
+        while (reference_position < data.size()) {
+            size_t size = std::min(data.size() - reference_position, (size_t)(rand() % 300));
+            reference_position += reference.find(data.data() + reference_position, size, reference_escaped) + 1;
+            position += scanner.find(data.data() + position, size, is_escaped) + 1;
+            CHECK_EQUAL(reference_position, position);
+            CHECK_EQUAL(reference_escaped, is_escaped);
+        }
+    }
+};
+
+TEST(slightscan, digit_count) {
+    const char alphabet[] = "a09;\"\n/:\xc3";
+    string data;
+    size_t data_digit_count = 0;
+    srand(2);
+    for (size_t i = 0; i < 5000; ++i) {
+        data += alphabet[rand() % (sizeof(alphabet) - 1)];
+        if (data[i] == '0' || data[i] == '9') {
+            ++data_digit_count;
+        }
+    }
+    for (int iset = SlightScanner::ISET_SCALAR; iset <= SlightScanner::ISET_AVX512; ++iset) {
+        SlightScanner scanner;
+        setupRowScanner(scanner);
+        scanner.setInstructionSet((SlightScanner::InstructionSet)iset);
+        // only the digits before the byte found are counted
+        bool is_escaped = false;
+        size_t digit_count = 0;
+        CHECK_EQUAL(4, scanner.find("1a23\n45", 7, is_escaped, digit_count));
+        CHECK_EQUAL(3, digit_count);
+        // walk the data counting the digits of the runs and of the bytes found
+        size_t position = 0;
+        digit_count = 0;
+        while (position < data.size()) {
+            position += scanner.find(data.data() + position, data.size() - position, is_escaped, digit_count);
+            if (position < data.size() && data[position] >= '0' && data[position] <= '9') {
+                ++digit_count;
+            }
+            ++position;
+        }
+        CHECK_EQUAL(data_digit_count, digit_count);
+    }
+};
+
+TEST(slightscan, multibyte_stop) {
+    SlightScanner scanner;
+    bool is_escaped = false;
+    setupRowScanner(scanner);
+    CHECK_EQUAL(true, scanner.getMultibyteStop());
+    // runs of multibyte characters are passed over, the setting is kept by clear()
+    scanner.setMultibyteStop(false);
+    scanner.clear();
+    setupRowScanner(scanner);
+    CHECK_EQUAL(false, scanner.getMultibyteStop());
+    string data = string(70, 'a') + "\xc3\xa9\xe2\x82\xac" + string(70, 'b') + "\n";
+    for (int iset = SlightScanner::ISET_SCALAR; iset <= SlightScanner::ISET_AVX512; ++iset) {
+        scanner.setInstructionSet((SlightScanner::InstructionSet)iset);
+        CHECK_EQUAL(data.size() - 1, scanner.find(data.data(), data.size(), is_escaped));
+    }
+    scanner.setMultibyteStop(true);
+    CHECK_EQUAL(70, scanner.find(data.data(), data.size(), is_escaped));
+};
+
+TEST(slightscan, utf8_validate) {
+    const string valid = "a\xc3\xa9" "b\xe2\x82\xac\xf0\x9f\x98\x80" + string(61, 'c') + "\xe2\x82\xac";
+    for (int iset = SlightScanner::ISET_SCALAR; iset <= SlightScanner::ISET_AVX512; ++iset) {
+        SlightUtf8Validator validator;
+        validator.setInstructionSet((SlightScanner::InstructionSet)iset);
+        CHECK_EQUAL(true, validator.validate("", 0));
+        CHECK_EQUAL(true, validator.validate(valid.data(), valid.size()));
+        // characters crossing the block boundary
+        string data = string(63, 'a') + valid;
+        CHECK_EQUAL(true, validator.validate(data.data(), data.size()));
+        // invalid lead byte, continuation byte without a lead byte, character broken by a plain byte
+        CHECK_EQUAL(false, validator.validate((data + "\xff").data(), data.size() + 1));
+        CHECK_EQUAL(false, validator.validate((data + "\x80").data(), data.size() + 1));
+        CHECK_EQUAL(false, validator.validate((data + "\xe2\x82" "a").data(), data.size() + 3));
+        CHECK_EQUAL(false, validator.validate((string(62, 'a') + "\xe2" "a\x82").data(), 65));
+        // incomplete character at the end
+        CHECK_EQUAL(false, validator.validate(valid.data(), valid.size() - 1));
+    }
+    CHECK_EQUAL(0, SlightUtf8Validator::getIncompleteSize(valid.data(), valid.size()));
+    CHECK_EQUAL(2, SlightUtf8Validator::getIncompleteSize(valid.data(), valid.size() - 1));
+    CHECK_EQUAL(1, SlightUtf8Validator::getIncompleteSize(valid.data(), valid.size() - 2));
+    CHECK_EQUAL(0, SlightUtf8Validator::getIncompleteSize(valid.data(), valid.size() - 3));
+    CHECK_EQUAL(3, SlightUtf8Validator::getIncompleteSize("\xf0\x9f\x98", 3));
+    CHECK_EQUAL(0, SlightUtf8Validator::getIncompleteSize("\x80", 1));
+};
+
+TEST(slightscan, utf8_instruction_sets_match) {
+    const char *chars[] = {"a", "b", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\x80", "\xff", "\xc3"};
+    string data;
+    srand(3);
+    // valid characters with an invalid sequence now and then
+    while (data.size() < 5000) {
+        data += chars[rand() % 50 ? rand() % 5 : 5 + rand() % 3];
+    }
+    SlightUtf8Validator reference;
+    reference.setInstructionSet(SlightScanner::ISET_SCALAR);
+    for (int iset = SlightScanner::ISET_SSE2; iset <= SlightScanner::ISET_AVX512; ++iset) {
+        SlightUtf8Validator validator;
+        validator.setInstructionSet((SlightScanner::InstructionSet)iset);
+        size_t valid_count = 0;
+        for (size_t i = 0; i < 2000; ++i) {
+            size_t position = rand() % data.size();
+            size_t size = std::min(data.size() - position, (size_t)(rand() % 200));
+            bool is_valid = reference.validate(data.data() + position, size);
+            CHECK_EQUAL(is_valid, validator.validate(data.data() + position, size));
+            valid_count += is_valid;
+        }
+        CHECK(valid_count > 0);
+    }
+};
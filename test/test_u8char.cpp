@@ -1206,4 +1206,35 @@ TEST(u8char, get_string) {
     }
     CHECK_EQUAL("", ex);
     CHECK_EQUAL("€", res);
-};
\ No newline at end of file
+};
+
+TEST(u8char, try_add_byte) {
+    U8char u1;
+    U8char u2;
+    U8char u3;
+    CHECK_EQUAL(U8char::STATUS_INCOMPLETE, u1.tryAddByte('\xe2'));
+    CHECK_EQUAL(U8char::STATUS_INCOMPLETE, u1.tryAddByte('\x82'));
+    CHECK_EQUAL(2, u1.getCount());
+    CHECK_EQUAL(U8char::STATUS_VALID, u1.tryAddByte('\xac'));
+    CHECK_EQUAL(U8char::STATUS_TOO_LONG, u1.tryAddByte('\xac'));
+    CHECK_EQUAL("€", string(u1.getData()));
+    // invalid bytes are not added
+    CHECK_EQUAL(U8char::STATUS_INVALID_LEAD, u2.tryAddByte('\xa8'));
+    CHECK_EQUAL(0, u2.getCount());
+    CHECK_EQUAL(U8char::STATUS_INCOMPLETE, u2.tryAddByte('\xc3'));
+    CHECK_EQUAL(U8char::STATUS_INVALID_CONTINUATION, u2.tryAddByte('a'));
+    CHECK_EQUAL(1, u2.getCount());
+    CHECK_EQUAL(U8char::STATUS_VALID, u3.tryAddByte('a'));
+};
+
+TEST(u8char, is_equal) {
+    U8char u1("a");
+    U8char u2("a");
+    U8char u3;
+    u3.addByte('\xc3');
+    // no exception for invalid objects, they are not equal to anything
+    CHECK_EQUAL(true, u1.isEqual(u2));
+    CHECK_EQUAL(false, u1.isEqual(U8char("b")));
+    CHECK_EQUAL(false, u1.isEqual(u3));
+    CHECK_EQUAL(false, u3.isEqual(u3));
+};